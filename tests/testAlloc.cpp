@@ -4,6 +4,8 @@
 #include <limits>
 #include <new>
 #include <cstdlib>
+#include <thread>
+#include <vector>
 
 TEST(MallocAllocator, littleSize) {
     using Alloc = tinystl::DebugAlloc<tinystl::DefaultAllocator>;
@@ -94,3 +96,316 @@ TEST(SimpleAlloc, allocate) {
     }
     Alloc::deallocate(as, 100000);
 }
+
+TEST(ThreadCacheAllocator, multiThreads) {
+    using Alloc = tinystl::DebugAlloc<tinystl::ThreadCacheAllocator>;
+    auto work = [](int seed) {
+        std::vector<std::pair<char *, std::size_t>> blocks;
+        for(int round = 0; round < 50; ++round) {
+            for(std::size_t size = 1; size <= 128; size += 7) {
+                char *buf = static_cast<char *>(Alloc::allocate(size));
+                std::memset(buf, seed, size);
+                blocks.push_back(std::make_pair(buf, size));
+            }
+            for(auto &block: blocks) {
+                for(std::size_t i = 0; i < block.second; ++i) {
+                    ASSERT_EQ(block.first[i], static_cast<char>(seed));
+                }
+                Alloc::deallocate(block.first, block.second);
+            }
+            blocks.clear();
+        }
+    };
+    std::vector<std::thread> workers;
+    for(int i = 0; i < 8; ++i) {
+        workers.push_back(std::thread(work, i + 1));
+    }
+    for(auto &worker: workers) {
+        worker.join();
+    }
+}
+
+TEST(ThreadCacheAllocator, freeOnOtherThread) {
+    using Alloc = tinystl::ThreadCacheAllocator;
+    const int count = 10000;
+    std::vector<int *> ptrs(count);
+    std::thread producer([&]() {
+        for(int i = 0; i < count; ++i) {
+            ptrs[i] = static_cast<int *>(Alloc::allocate(sizeof(int)));
+            *ptrs[i] = i;
+        }
+    });
+    producer.join();
+    std::thread consumer([&]() {
+        for(int i = 0; i < count; ++i) {
+            ASSERT_EQ(*ptrs[i], i);
+            Alloc::deallocate(ptrs[i], sizeof(int));
+        }
+    });
+    consumer.join();
+    // 归还到中心池的对象可以被其它线程重新使用
+    int *ptr = static_cast<int *>(Alloc::allocate(sizeof(int)));
+    *ptr = 1;
+    ASSERT_EQ(*ptr, 1);
+    Alloc::deallocate(ptr, sizeof(int));
+}
+
+TEST(ThreadCacheAllocator, allocateAfterThreadExit) {
+    using Alloc = tinystl::DefaultAlloc<5, true, true>;
+    // 先构造的thread_local后析构,析构时线程缓存已经归还给中心池
+    struct LateUser {
+        ~LateUser() {
+            std::vector<void *> ptrs;
+            for(int i = 0; i < 1000; ++i) {
+                int *ptr = static_cast<int *>(Alloc::allocate(32));
+                *ptr = i;
+                ptrs.push_back(ptr);
+            }
+            for(int i = 0; i < 1000; ++i) {
+                EXPECT_EQ(*static_cast<int *>(ptrs[i]), i);
+                Alloc::deallocate(ptrs[i], 32);
+            }
+        }
+    };
+    std::thread worker([]() {
+        static thread_local LateUser user;
+        (void)user;
+        Alloc::deallocate(Alloc::allocate(32), 32);
+    });
+    worker.join();
+    Alloc::Stats stats = Alloc::getStats();
+    ASSERT_EQ(stats.sizeClasses[3].allocations, 1001);
+    ASSERT_EQ(stats.sizeClasses[3].deallocations, 1001);
+    ASSERT_EQ(stats.sizeClasses[3].cachedObjects, 0);
+    // 所有对象都回到了中心池,chunk可以全部还给系统
+    Alloc::trim();
+    ASSERT_EQ(Alloc::getStats().chunkBytes, 0);
+}
+
+TEST(DefaultAlloc, stats) {
+    using Alloc = tinystl::DefaultAlloc<1, false, true>;
+    std::vector<void *> ptrs;
+    for(int i = 0; i < 100; ++i) {
+        ptrs.push_back(Alloc::allocate(16));
+    }
+    void *large = Alloc::allocate(1024);
+    for(auto ptr: ptrs) {
+        Alloc::deallocate(ptr, 16);
+    }
+    Alloc::deallocate(large, 1024);
+
+    Alloc::Stats stats = Alloc::getStats();
+    const Alloc::Stats::SizeClass &sizeClass = stats.sizeClasses[1];
+    ASSERT_EQ(sizeClass.objectSize, 16);
+    ASSERT_EQ(sizeClass.allocations, 100);
+    ASSERT_EQ(sizeClass.deallocations, 100);
+    ASSERT_EQ(sizeClass.hits + sizeClass.refills, 100);
+    ASSERT_GT(sizeClass.hits, sizeClass.refills);
+    ASSERT_GE(sizeClass.cachedObjects, 100);
+    ASSERT_EQ(stats.largeAllocations, 1);
+    ASSERT_EQ(stats.largeDeallocations, 1);
+    ASSERT_GT(stats.chunkCount, 0);
+    ASSERT_GE(stats.freeListBytes(), 100 * 16);
+    ASSERT_LE(stats.freeListBytes(), stats.chunkBytes);
+}
+
+TEST(ThreadCacheAllocator, stats) {
+    using Alloc = tinystl::DefaultAlloc<1, true, true>;
+    auto work = []() {
+        std::vector<void *> ptrs;
+        for(int i = 0; i < 1000; ++i) {
+            ptrs.push_back(Alloc::allocate(32));
+        }
+        for(auto ptr: ptrs) {
+            Alloc::deallocate(ptr, 32);
+        }
+    };
+    std::thread first(work);
+    std::thread second(work);
+    first.join();
+    second.join();
+
+    Alloc::Stats stats = Alloc::getStats();
+    const Alloc::Stats::SizeClass &sizeClass = stats.sizeClasses[3];
+    ASSERT_EQ(sizeClass.allocations, 2000);
+    ASSERT_EQ(sizeClass.deallocations, 2000);
+    ASSERT_GT(sizeClass.centralReleases, 0);
+    // 线程退出后对象都归还给了中心池
+    ASSERT_EQ(sizeClass.cachedObjects, 0);
+    ASSERT_GE(sizeClass.centralObjects, 1000);
+    ASSERT_EQ(stats.threadCount, 0);
+}
+
+TEST(ThreadCacheAllocator, largeStats) {
+    using Alloc = tinystl::DefaultAlloc<7, true, true>;
+    // 线程退出后的大对象分配
+    struct LateUser {
+        ~LateUser() {
+            Alloc::deallocate(Alloc::allocate(1000), 1000);
+        }
+    };
+    // 只分配大对象的线程
+    std::thread large([]() {
+        void *ptr = Alloc::allocate(1000);
+        ASSERT_EQ(Alloc::getStats().largeAllocations, 1);
+        Alloc::deallocate(ptr, 1000);
+    });
+    large.join();
+    std::thread late([]() {
+        static thread_local LateUser user;
+        (void)user;
+        Alloc::deallocate(Alloc::allocate(8), 8);
+    });
+    late.join();
+    Alloc::Stats stats = Alloc::getStats();
+    ASSERT_EQ(stats.largeAllocations, 2);
+    ASSERT_EQ(stats.largeDeallocations, 2);
+    ASSERT_EQ(stats.threadCount, 0);
+}
+
+TEST(DefaultAlloc, trim) {
+    using Alloc = tinystl::DefaultAlloc<2, false, true>;
+    std::vector<void *> ptrs;
+    for(int i = 0; i < 5000; ++i) {
+        ptrs.push_back(Alloc::allocate(8 * (i % 16 + 1)));
+    }
+    for(int i = 0; i < 5000; ++i) {
+        Alloc::deallocate(ptrs[i], 8 * (i % 16 + 1));
+    }
+    std::size_t chunkBytes = Alloc::getStats().chunkBytes;
+    std::size_t releasedBytes = Alloc::trim();
+    Alloc::Stats stats = Alloc::getStats();
+    ASSERT_GT(releasedBytes, 0);
+    ASSERT_EQ(stats.chunkBytes + releasedBytes, chunkBytes);
+    ASSERT_LE(stats.freeListBytes(), stats.chunkBytes);
+    ASSERT_EQ(Alloc::trim(), 0);
+
+    // trim后仍然可以正常分配
+    ptrs.clear();
+    for(int i = 0; i < 1000; ++i) {
+        int *ptr = static_cast<int *>(Alloc::allocate(sizeof(int)));
+        *ptr = i;
+        ptrs.push_back(ptr);
+    }
+    for(int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(*static_cast<int *>(ptrs[i]), i);
+        Alloc::deallocate(ptrs[i], sizeof(int));
+    }
+}
+
+TEST(DefaultAlloc, autoTrim) {
+    using Alloc = tinystl::DefaultAlloc<6, false, true>;
+    Alloc::setAutoTrimThreshold(4096);
+    std::vector<void *> ptrs;
+    for(int i = 0; i < 20000; ++i) {
+        ptrs.push_back(Alloc::allocate(32));
+    }
+    std::size_t chunkBytes = Alloc::getStats().chunkBytes;
+    for(auto ptr: ptrs) {
+        Alloc::deallocate(ptr, 32);
+    }
+    Alloc::Stats stats = Alloc::getStats();
+    ASSERT_LE(stats.freeListBytes(), stats.chunkBytes);
+    ASSERT_LT(stats.chunkBytes, chunkBytes / 2);
+    Alloc::setAutoTrimThreshold(0);
+}
+
+TEST(ThreadCacheAllocator, autoTrim) {
+    using Alloc = tinystl::DefaultAlloc<2, true, true>;
+    Alloc::setAutoTrimThreshold(4096);
+    auto work = []() {
+        std::vector<void *> ptrs;
+        for(int i = 0; i < 2000; ++i) {
+            ptrs.push_back(Alloc::allocate(64));
+        }
+        for(auto ptr: ptrs) {
+            Alloc::deallocate(ptr, 64);
+        }
+    };
+    std::thread first(work);
+    first.join();
+    std::thread second(work);
+    second.join();
+    Alloc::Stats stats = Alloc::getStats();
+    ASSERT_LE(stats.freeListBytes(), stats.chunkBytes);
+    ASSERT_LT(stats.chunkBytes, 2000 * 64);
+    Alloc::setAutoTrimThreshold(0);
+}
+
+TEST(SizeClasses, geometric) {
+    using SizeClasses = tinystl::GeometricSizeClasses<16, 4096>;
+    ASSERT_EQ(SizeClasses::size(SizeClasses::COUNT - 1), 4096);
+    for(std::size_t n = 1; n <= 4096; ++n) {
+        std::size_t index = SizeClasses::index(n);
+        ASSERT_LT(index, SizeClasses::COUNT);
+        ASSERT_GE(SizeClasses::size(index), n);
+        ASSERT_EQ(SizeClasses::size(index) % 16, 0);
+        if(index > 0) {
+            ASSERT_LT(SizeClasses::size(index - 1), n);
+        }
+    }
+    ASSERT_EQ(SizeClasses::batch(0), 32);
+    ASSERT_EQ(SizeClasses::batch(SizeClasses::COUNT - 1), 2);
+}
+
+TEST(DefaultAlloc, geometricSizeClasses) {
+    using Alloc = tinystl::DefaultAlloc<3, false, true, tinystl::GeometricSizeClasses<64, 4096>>;
+    std::vector<void *> ptrs;
+    for(int i = 0; i < 2000; ++i) {
+        std::size_t size = 150 + i % 250;
+        char *ptr = static_cast<char *>(Alloc::allocate(size));
+        ASSERT_EQ(reinterpret_cast<std::size_t>(ptr) % 64, 0);
+        std::memset(ptr, i, size);
+        ptrs.push_back(ptr);
+    }
+    for(int i = 0; i < 2000; ++i) {
+        std::size_t size = 150 + i % 250;
+        ASSERT_EQ(static_cast<char *>(ptrs[i])[size - 1], static_cast<char>(i));
+        Alloc::deallocate(ptrs[i], size);
+    }
+    Alloc::Stats stats = Alloc::getStats();
+    ASSERT_EQ(stats.largeAllocations, 0);
+    ASSERT_LE(stats.freeListBytes(), stats.chunkBytes);
+    ASSERT_GT(Alloc::trim(), 0);
+}
+
+TEST(HugePageChunkSource, allocate) {
+    using ChunkSource = tinystl::HugePageChunkSource<>;
+    std::size_t size = 100;
+    char *ptr = static_cast<char *>(ChunkSource::allocate(size, 64));
+    ASSERT_NE(ptr, nullptr);
+    ASSERT_GE(size, 100);
+    std::memset(ptr, 1, size);
+    ChunkSource::deallocate(ptr, size);
+
+    // 超过regionSize的对齐要求
+    using SmallRegion = tinystl::HugePageChunkSource<4096>;
+    size = 100;
+    ptr = static_cast<char *>(SmallRegion::allocate(size, 1 << 16));
+    ASSERT_NE(ptr, nullptr);
+#if defined(__linux__)
+    ASSERT_EQ(size, 4096);
+    ASSERT_EQ(reinterpret_cast<std::size_t>(ptr) % (1 << 16), 0);
+#endif
+    std::memset(ptr, 1, size);
+    SmallRegion::deallocate(ptr, size);
+}
+
+TEST(DefaultAlloc, hugePageChunks) {
+    using Alloc = tinystl::DefaultAlloc<4, true, true, tinystl::GeometricSizeClasses<16, 4096>,
+                                        tinystl::HugePageChunkSource<>>;
+    std::vector<void *> ptrs;
+    for(int i = 0; i < 100000; ++i) {
+        int *ptr = static_cast<int *>(Alloc::allocate(48));
+        *ptr = i;
+        ptrs.push_back(ptr);
+    }
+    for(int i = 0; i < 100000; ++i) {
+        ASSERT_EQ(*static_cast<int *>(ptrs[i]), i);
+        Alloc::deallocate(ptrs[i], 48);
+    }
+    Alloc::Stats stats = Alloc::getStats();
+    ASSERT_GE(stats.chunkBytes, 100000 * 48);
+    ASSERT_EQ(Alloc::trim(), stats.chunkBytes);
+    ASSERT_EQ(Alloc::getStats().chunkBytes, 0);
+}
@@ -0,0 +1,224 @@
+#include <gtest/gtest.h>
+#include <iostream>
+#include <new>
+#include "../tinystl/arena.h"
+#include "../tinystl/algobase.h"
+#include "../tinystl/vector.h"
+#include "../tinystl/list.h"
+#include "../tinystl/deque.h"
+#include "../tinystl/rbtree.h"
+#include "../tinystl/hashtable.h"
+#include "../tinystl/map.h"
+#include "../tinystl/set.h"
+#include "../tinystl/multimap.h"
+#include "../tinystl/multiset.h"
+#include "../tinystl/unorderedmap.h"
+#include "../tinystl/unorderedset.h"
+#include "../tinystl/unorderedmultimap.h"
+#include "../tinystl/unorderedmultiset.h"
+
+struct Identity {
+    const int& operator()(const int &x) const {
+        return x;
+    }
+};
+
+struct IntHash {
+    std::size_t operator()(int x) const {
+        return x;
+    }
+};
+
+TEST(Arena, allocate) {
+    tinystl::Arena arena(256);
+    char *first = static_cast<char *>(arena.allocate(3));
+    char *second = static_cast<char *>(arena.allocate(5));
+    ASSERT_NE(first, second);
+    ASSERT_EQ(reinterpret_cast<std::size_t>(second) % alignof(std::max_align_t), 0);
+
+    // 大于块大小的分配
+    char *large = static_cast<char *>(arena.allocate(10000));
+    for(int i = 0; i < 10000; ++i) {
+        large[i] = 1;
+    }
+    ASSERT_GE(arena.reservedBytes(), 10000);
+
+    // 最后一次分配可以原地扩展和回收
+    std::size_t used = arena.usedBytes();
+    char *last = static_cast<char *>(arena.allocate(16));
+    ASSERT_EQ(arena.reallocate(last, 16, 64), last);
+    arena.deallocate(last, 64);
+    ASSERT_EQ(arena.usedBytes(), used);
+
+    arena.reset();
+    ASSERT_EQ(arena.usedBytes(), 0);
+    std::size_t reserved = arena.reservedBytes();
+    for(int i = 0; i < 100; ++i) {
+        arena.allocate(64);
+    }
+    ASSERT_EQ(arena.reservedBytes(), reserved);
+}
+
+TEST(ArenaAllocator, scope) {
+    ASSERT_THROW(tinystl::ArenaAllocator::allocate(8), std::bad_alloc);
+    tinystl::Arena outer, inner;
+    {
+        tinystl::ArenaScope outerScope(outer);
+        ASSERT_EQ(tinystl::ArenaAllocator::current(), &outer);
+        {
+            tinystl::ArenaScope innerScope(inner);
+            ASSERT_EQ(tinystl::ArenaAllocator::current(), &inner);
+        }
+        ASSERT_EQ(tinystl::ArenaAllocator::current(), &outer);
+    }
+    ASSERT_EQ(tinystl::ArenaAllocator::current(), nullptr);
+}
+
+TEST(ArenaAllocator, containers) {
+    tinystl::Arena arena;
+    for(int round = 0; round < 3; ++round) {
+        {
+            tinystl::ArenaScope scope(arena);
+            tinystl::Vector<int, tinystl::ArenaAllocator> v;
+            tinystl::List<int, tinystl::ArenaAllocator> l;
+            tinystl::RBTree<int, int, Identity, tinystl::Less<int>, tinystl::ArenaAllocator> t;
+            tinystl::HashTable<int, int, IntHash, Identity,
+                               tinystl::Equal<int>, tinystl::ArenaAllocator> h;
+            for(int i = 0; i < 1000; ++i) {
+                v.pushBack(i);
+                l.pushBack(i);
+                t.insertUnique(i);
+                h.insertUnique(i);
+            }
+            ASSERT_EQ(v.size(), 1000);
+            ASSERT_EQ(l.size(), 1000);
+            ASSERT_EQ(t.size(), 1000);
+            ASSERT_EQ(h.size(), 1000);
+            ASSERT_TRUE(t.rbVerify());
+            for(int i = 0; i < 1000; ++i) {
+                ASSERT_EQ(v[i], i);
+                ASSERT_EQ(*t.find(i), i);
+                ASSERT_EQ(*h.find(i), i);
+            }
+            ASSERT_GT(arena.usedBytes(), 0);
+        }
+        arena.reset();
+    }
+}
+
+TEST(ArenaRef, statelessAllocatorCostsNothing) {
+    ASSERT_EQ(sizeof(tinystl::Vector<int>), 3 * sizeof(int *));
+    ASSERT_EQ(sizeof(tinystl::List<int>), sizeof(void *));
+    ASSERT_GT(sizeof(tinystl::Vector<int, tinystl::ArenaRef>), 3 * sizeof(int *));
+}
+
+TEST(ArenaRef, containers) {
+    tinystl::Arena first, second;
+    tinystl::ArenaRef firstRef(first), secondRef(second);
+    tinystl::Vector<int, tinystl::ArenaRef> v(firstRef);
+    tinystl::List<int, tinystl::ArenaRef> l(firstRef);
+    tinystl::Deque<int, tinystl::ArenaRef> d(firstRef);
+    tinystl::RBTree<int, int, Identity, tinystl::Less<int>, tinystl::ArenaRef> t(tinystl::Less<int>(), secondRef);
+    tinystl::HashTable<int, int, IntHash, Identity,
+                       tinystl::Equal<int>, tinystl::ArenaRef> h(53, tinystl::Equal<int>(), Identity(),
+                                                                 IntHash(), secondRef);
+    std::size_t firstUsed = first.usedBytes();
+    std::size_t secondUsed = second.usedBytes();
+    for(int i = 0; i < 1000; ++i) {
+        v.pushBack(i);
+        l.pushBack(i);
+        d.pushBack(i);
+    }
+    ASSERT_GT(first.usedBytes(), firstUsed);
+    ASSERT_EQ(second.usedBytes(), secondUsed);
+    for(int i = 0; i < 1000; ++i) {
+        t.insertUnique(i);
+        h.insertUnique(i);
+    }
+    ASSERT_GT(second.usedBytes(), secondUsed);
+    ASSERT_EQ(v.getAllocator(), firstRef);
+    ASSERT_EQ(t.getAllocator(), secondRef);
+    ASSERT_EQ(h.getAllocator(), secondRef);
+
+    // 复制时沿用原容器的分配器
+    tinystl::Vector<int, tinystl::ArenaRef> copy(v);
+    ASSERT_EQ(copy.getAllocator(), firstRef);
+    ASSERT_TRUE(copy == v);
+    tinystl::List<int, tinystl::ArenaRef> other(secondRef);
+    l.swap(other);
+    ASSERT_EQ(l.getAllocator(), secondRef);
+    ASSERT_EQ(other.getAllocator(), firstRef);
+    ASSERT_EQ(other.size(), 1000);
+    other.sort();
+    ASSERT_EQ(other.front(), 0);
+    ASSERT_EQ(other.back(), 999);
+    ASSERT_EQ(other.getAllocator(), firstRef);
+
+    // 没有绑定Arena时分配失败
+    tinystl::Vector<int, tinystl::ArenaRef> empty;
+    ASSERT_THROW(empty.pushBack(1), std::bad_alloc);
+}
+
+TEST(ArenaRef, orderedAdaptors) {
+    tinystl::Arena arena;
+    tinystl::ArenaRef ref(arena);
+    tinystl::Map<int, int, tinystl::Less<int>, tinystl::ArenaRef> m(ref);
+    tinystl::Set<int, tinystl::Less<int>, tinystl::ArenaRef> s(tinystl::Less<int>(), ref);
+    tinystl::MultiMap<int, int, tinystl::Less<int>, tinystl::ArenaRef> mm(ref);
+    int data[] = {3, 1, 2, 3};
+    tinystl::MultiSet<int, tinystl::Less<int>, tinystl::ArenaRef> ms(data, data + 4,
+                                                                   tinystl::Less<int>(), ref);
+    std::size_t used = arena.usedBytes();
+    for(int i = 0; i < 100; ++i) {
+        m[i] = i;
+        s.insert(i);
+        mm.insert(tinystl::makePair(i % 10, i));
+    }
+    ASSERT_GT(arena.usedBytes(), used);
+    ASSERT_EQ(m.getAllocator(), ref);
+    ASSERT_EQ(s.getAllocator(), ref);
+    ASSERT_EQ(mm.getAllocator(), ref);
+    ASSERT_EQ(ms.getAllocator(), ref);
+    ASSERT_EQ(m.size(), 100);
+    ASSERT_EQ(mm.count(3), 10);
+    ASSERT_EQ(ms.count(3), 2);
+
+    // 复制时沿用原容器的分配器
+    tinystl::Map<int, int, tinystl::Less<int>, tinystl::ArenaRef> copy(m);
+    ASSERT_EQ(copy.getAllocator(), ref);
+    ASSERT_TRUE(copy == m);
+}
+
+TEST(ArenaRef, unorderedAdaptors) {
+    tinystl::Arena arena;
+    tinystl::ArenaRef ref(arena);
+    using Hash = tinystl::Hash<int>;
+    using Equal = tinystl::Equal<int>;
+    tinystl::UnorderedMap<int, int, Hash, Equal, tinystl::ArenaRef> m(ref);
+    tinystl::UnorderedSet<int, Hash, Equal, tinystl::ArenaRef> s(16, Hash(), Equal(), ref);
+    tinystl::UnorderedMultiMap<int, int, Hash, Equal, tinystl::ArenaRef> mm(ref);
+    int data[] = {3, 1, 2, 3};
+    tinystl::UnorderedMultiSet<int, Hash, Equal, tinystl::ArenaRef> ms(data, data + 4, 0,
+                                                                     Hash(), Equal(), ref);
+    std::size_t used = arena.usedBytes();
+    for(int i = 0; i < 100; ++i) {
+        m[i] = i;
+        s.insert(i);
+        mm.insert(tinystl::makePair(i % 10, i));
+    }
+    ASSERT_GT(arena.usedBytes(), used);
+    ASSERT_EQ(m.getAllocator(), ref);
+    ASSERT_EQ(s.getAllocator(), ref);
+    ASSERT_EQ(mm.getAllocator(), ref);
+    ASSERT_EQ(ms.getAllocator(), ref);
+    ASSERT_EQ(m.size(), 100);
+    ASSERT_EQ(s.count(42), 1);
+    ASSERT_EQ(mm.count(3), 10);
+    ASSERT_EQ(ms.count(3), 2);
+}
+
+int main(int argc, char *argv[])
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../tinystl/concurrenthashmap.h"
+
+using Map = tinystl::ConcurrentHashMap<int, int>;
+
+TEST(ConcurrentHashMap, basic) {
+    Map a(10);
+    ASSERT_EQ(a.shardCount(), 16);
+    ASSERT_TRUE(a.empty());
+    ASSERT_TRUE(a.insertOrAssign(1, 10));
+    ASSERT_FALSE(a.insertOrAssign(1, 11));
+    ASSERT_TRUE(a.insert(tinystl::Pair<int, int>(2, 20)));
+    ASSERT_FALSE(a.insert(tinystl::Pair<int, int>(2, 21)));
+    ASSERT_TRUE(a.tryEmplace(3, 30));
+    ASSERT_FALSE(a.tryEmplace(3, 31));
+    ASSERT_EQ(a.size(), 3);
+
+    int value = 0;
+    ASSERT_TRUE(a.find(1, value));
+    ASSERT_EQ(value, 11);
+    ASSERT_TRUE(a.find(2, value));
+    ASSERT_EQ(value, 20);
+    ASSERT_FALSE(a.find(4, value));
+    ASSERT_TRUE(a.contains(3));
+    ASSERT_FALSE(a.contains(4));
+
+    ASSERT_TRUE(a.findAndApply(3, [](int &v) { v += 5; }));
+    ASSERT_FALSE(a.findAndApply(4, [](int &v) { v += 5; }));
+    const Map &b = a;
+    ASSERT_TRUE(b.findAndApply(3, [&value](const int &v) { value = v; }));
+    ASSERT_EQ(value, 35);
+
+    ASSERT_FALSE(a.eraseIf(3, [](const int &v) { return v < 35; }));
+    ASSERT_TRUE(a.eraseIf(3, [](const int &v) { return v == 35; }));
+    ASSERT_FALSE(a.contains(3));
+    ASSERT_TRUE(a.erase(2));
+    ASSERT_FALSE(a.erase(2));
+    ASSERT_EQ(a.size(), 1);
+
+    for(int i = 0; i < 1000; ++i) {
+        a.insertOrAssign(i, i);
+    }
+    ASSERT_EQ(a.eraseIf([](const tinystl::Pair<int, int> &p) { return p.first % 2 == 0; }), 500);
+    int count = 0;
+    a.forEach([&count](const tinystl::Pair<int, int> &p) {
+        ASSERT_EQ(p.first % 2, 1);
+        ++count;
+    });
+    ASSERT_EQ(count, 500);
+    a.clear();
+    ASSERT_TRUE(a.empty());
+
+    // 只有一个分片
+    tinystl::ConcurrentHashMap<std::string, std::string> c(1);
+    ASSERT_EQ(c.shardCount(), 1);
+    c.reserve(100);
+    ASSERT_TRUE(c.insertOrAssign("hello", std::string("world")));
+    std::string s;
+    ASSERT_TRUE(c.find("hello", s));
+    ASSERT_EQ(s, "world");
+}
+
+TEST(ConcurrentHashMap, threads) {
+    Map a;
+    const int THREADS = 8;
+    const int N = 20000;
+    std::vector<std::thread> workers;
+    // 每个线程插入自己的键,同时所有线程都对共享的计数器加一
+    a.insertOrAssign(-1, 0);
+    for(int t = 0; t < THREADS; ++t) {
+        workers.push_back(std::thread([&a, t]() {
+            for(int i = 0; i < N; ++i) {
+                a.insertOrAssign(t * N + i, i);
+                a.findAndApply(-1, [](int &v) { ++v; });
+                int value = -1;
+                if(i > 0 && i % 4 != 1) {
+                    EXPECT_TRUE(a.find(t * N + i - 1, value));
+                    EXPECT_EQ(value, i - 1);
+                }
+                if(i % 2 == 0) {
+                    a.eraseIf(t * N + i, [](const int &v) { return v % 4 == 0; });
+                }
+            }
+        }));
+    }
+    for(auto &worker: workers) {
+        worker.join();
+    }
+    int counter = 0;
+    ASSERT_TRUE(a.find(-1, counter));
+    ASSERT_EQ(counter, THREADS * N);
+    ASSERT_EQ(a.size(), THREADS * N * 3 / 4 + 1);
+    for(int i = 0; i < THREADS * N; ++i) {
+        ASSERT_EQ(a.contains(i), i % N % 4 != 0);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <iostream>
 #include <deque>
+#include <string>
 #include "../tinystl/deque.h"
 
 TEST(Deque, constructors) {
@@ -180,6 +181,41 @@ TEST(Deque, swap) {
     ASSERT_EQ(d.size(), 10);
 }
 
+TEST(Deque, move) {
+    tinystl::Deque<std::string> d;
+    for(int i = 0; i < 1000; ++i) {
+        d.pushBack(std::to_string(i));
+        d.pushFront(std::to_string(-i));
+    }
+    d.insert(d.cbegin() + 10, std::string("x"));
+    ASSERT_EQ(d.size(), 2001);
+    ASSERT_EQ(d[10], "x");
+    ASSERT_EQ(d[11], "-989");
+
+    tinystl::Deque<std::string> d2(tinystl::move(d));
+    ASSERT_TRUE(d.empty());
+    ASSERT_EQ(d2.size(), 2001);
+    ASSERT_EQ(d2.back(), "999");
+
+    d = tinystl::move(d2);
+    ASSERT_TRUE(d2.empty());
+    ASSERT_EQ(d.front(), "-999");
+}
+
+TEST(Deque, emplace) {
+    tinystl::Deque<std::string> d;
+    for(int i = 0; i < 100; ++i) {
+        d.emplaceBack(3, 'b');
+        d.emplaceFront(1, 'f');
+    }
+    auto it = d.emplace(d.cbegin() + 50, "middle");
+    ASSERT_EQ(*it, "middle");
+    ASSERT_EQ(d.size(), 201);
+    ASSERT_EQ(d.front(), "f");
+    ASSERT_EQ(d.back(), "bbb");
+    ASSERT_EQ(d[50], "middle");
+}
+
 int main(int argc, char *argv[])
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "../tinystl/flathashtable.h"
+#include "../tinystl/algobase.h"
+#include "../tinystl/alloc.h"
+#include "../tinystl/hash.h"
+
+template<typename T>
+struct KeyExtractor {
+    const T& operator()(const T &value) const {
+        return value;
+    }
+};
+
+using FlatHashTable = tinystl::FlatHashTable<int, int, tinystl::Hash<int>,
+                                             KeyExtractor<int>, tinystl::Equal<int>,
+                                             tinystl::Alloc>;
+using StringTable = tinystl::FlatHashTable<std::string, std::string, tinystl::Hash<std::string>,
+                                           KeyExtractor<std::string>, tinystl::Equal<std::string>,
+                                           tinystl::Alloc>;
+
+TEST(FlatHashTable, constructors) {
+    FlatHashTable a;
+    ASSERT_TRUE(a.empty());
+    ASSERT_EQ(a.size(), 0);
+    ASSERT_TRUE(a.begin() == a.end());
+    ASSERT_TRUE(a.find(1) == a.end());
+    ASSERT_EQ(a.erase(1), 0);
+
+    FlatHashTable b(100, tinystl::Equal<int>(), KeyExtractor<int>(), tinystl::Hash<int>());
+    ASSERT_GE(b.bucketCount(), 100);
+    const std::size_t bucketCount = b.bucketCount();
+    for(int i = 0; i < 100; ++i) {
+        b.insertUnique(i);
+    }
+    ASSERT_EQ(b.bucketCount(), bucketCount);
+}
+
+TEST(FlatHashTable, maintainers) {
+    FlatHashTable a;
+    auto res = a.insertUnique(1);
+    ASSERT_TRUE(res.second);
+    ASSERT_EQ(*res.first, 1);
+    res = a.insertUnique(1);
+    ASSERT_FALSE(res.second);
+    ASSERT_EQ(a.size(), 1);
+
+    for(int i = 0; i < 10000; ++i) {
+        a.insertUnique(i * 16);
+    }
+    ASSERT_EQ(a.size(), 10001);
+    for(int i = 0; i < 10000; ++i) {
+        ASSERT_EQ(*a.find(i * 16), i * 16);
+        ASSERT_EQ(a.count(i * 16 + 3), 0);
+    }
+    ASSERT_EQ(tinystl::distance(a.begin(), a.end()), 10001);
+
+    for(int i = 0; i < 10000; i += 2) {
+        ASSERT_EQ(a.erase(i * 16), 1);
+    }
+    ASSERT_EQ(a.size(), 5001);
+    for(int i = 0; i < 10000; ++i) {
+        ASSERT_EQ(a.count(i * 16), i % 2);
+    }
+
+    a.erase(a.find(1));
+    ASSERT_EQ(a.count(1), 0);
+    a.clear();
+    ASSERT_TRUE(a.empty());
+    ASSERT_TRUE(a.begin() == a.end());
+}
+
+TEST(FlatHashTable, tombstones) {
+    // 反复插入删除,已删除的槽被复用或整理掉,容量不会一直增长
+    FlatHashTable a;
+    std::unordered_set<int> expected;
+    for(int round = 0; round < 100; ++round) {
+        for(int i = 0; i < 100; ++i) {
+            a.insertUnique(round * 100 + i);
+            expected.insert(round * 100 + i);
+        }
+        for(int i = 0; i < 100; i += 3) {
+            a.erase(round * 100 + i);
+            expected.erase(round * 100 + i);
+        }
+        for(auto it = a.begin(); it != a.end();) {
+            if(*it % 7 == 0) {
+                expected.erase(*it);
+                a.erase(it++);
+            } else {
+                ++it;
+            }
+        }
+    }
+    ASSERT_EQ(a.size(), expected.size());
+    for(int x: expected) {
+        ASSERT_EQ(a.count(x), 1);
+    }
+    ASSERT_LE(a.bucketCount(), 16384);
+}
+
+TEST(FlatHashTable, values) {
+    StringTable a;
+    for(int i = 0; i < 1000; ++i) {
+        a.insertUnique(std::to_string(i));
+    }
+    std::string s("hello");
+    a.insertUnique(tinystl::move(s));
+    ASSERT_TRUE(s.empty());
+    ASSERT_TRUE(a.emplaceUnique(3, 'x').second);
+    ASSERT_FALSE(a.emplaceUnique("xxx").second);
+    ASSERT_EQ(a.size(), 1002);
+    ASSERT_EQ(*a.find("999"), "999");
+
+    StringTable b(a);
+    ASSERT_TRUE(a == b);
+    b.erase("hello");
+    ASSERT_TRUE(a != b);
+    b = a;
+    ASSERT_TRUE(a == b);
+
+    StringTable c(tinystl::move(b));
+    ASSERT_TRUE(b.empty());
+    ASSERT_TRUE(b.find("1") == b.end());
+    ASSERT_EQ(c.size(), 1002);
+    b = tinystl::move(c);
+    ASSERT_EQ(b.size(), 1002);
+    b.swap(c);
+    ASSERT_TRUE(b.empty());
+    ASSERT_EQ(c.count("hello"), 1);
+
+    std::vector<std::string> words = {"a", "b", "a", "c"};
+    b.insertUnique(words.begin(), words.end());
+    ASSERT_EQ(b.size(), 3);
+}
+
+int main(int argc, char *argv[])
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
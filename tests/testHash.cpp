@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include <set>
+#include <string>
+#include "../tinystl/hash.h"
+
+TEST(Hash, integers) {
+    tinystl::Hash<int> hash;
+    ASSERT_EQ(hash(42), hash(42));
+    ASSERT_NE(hash(1), hash(2));
+    ASSERT_EQ(tinystl::Hash<long>()(7), tinystl::Hash<unsigned long>()(7ul));
+
+    // 连续整数的哈希值低位也应该分布均匀
+    int buckets[64] = {0};
+    for(int i = 0; i < 64 * 100; ++i) {
+        ++buckets[hash(i) & 63];
+    }
+    for(int i = 0; i < 64; ++i) {
+        ASSERT_GT(buckets[i], 50);
+        ASSERT_LT(buckets[i], 150);
+    }
+}
+
+TEST(Hash, pointers) {
+    int values[4];
+    tinystl::Hash<int *> hash;
+    ASSERT_EQ(hash(values), hash(values));
+    ASSERT_NE(hash(values), hash(values + 1));
+    ASSERT_EQ(tinystl::Hash<const int *>()(values), hash(values));
+}
+
+TEST(Hash, strings) {
+    tinystl::Hash<std::string> hash;
+    ASSERT_EQ(hash("hello"), hash(std::string("hello")));
+    ASSERT_EQ(hash("hello"), tinystl::Hash<const char *>()("hello"));
+    char buffer[] = "hello";
+    ASSERT_EQ(hash("hello"), tinystl::Hash<char *>()(buffer));
+    ASSERT_NE(hash("hello"), hash("hellp"));
+
+    // 覆盖各个长度分支,包括超过48字节的长字符串
+    std::set<std::size_t> seen;
+    std::string s;
+    for(int len = 0; len <= 200; ++len) {
+        ASSERT_TRUE(seen.insert(hash(s)).second);
+        s.push_back(static_cast<char>('a' + len % 26));
+    }
+    // 只改变长字符串中的一个字节
+    const std::size_t h = hash(s);
+    for(std::size_t i = 0; i < s.size(); ++i) {
+        std::string t = s;
+        t[i] ^= 1;
+        ASSERT_NE(hash(t), h);
+    }
+
+    std::wstring w(L"hello");
+    ASSERT_EQ(tinystl::Hash<std::wstring>()(w), tinystl::Hash<std::wstring>()(L"hello"));
+}
+
+int main(int argc, char *argv[])
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
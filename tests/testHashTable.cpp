@@ -1,16 +1,12 @@
 #include <gtest/gtest.h>
 #include <iostream>
+#include <stdexcept>
+#include <string>
 #include <vector>
 #include "../tinystl/algobase.h"
 #include "../tinystl/hashtable.h"
 #include "../tinystl/alloc.h"
-
-template<typename T>
-struct HashFun {
-    const T& operator()(const T &value) const {
-        return value;
-    }
-};
+#include "../tinystl/hash.h"
 
 template<typename T>
 struct KeyExtractor {
@@ -19,10 +15,29 @@ struct KeyExtractor {
     }
 };
 
-using HashTable = tinystl::HashTable<int, int, HashFun<int>,
+using HashTable = tinystl::HashTable<int, int, tinystl::Hash<int>,
                                      KeyExtractor<int>, tinystl::Equal<int>,
                                      tinystl::Alloc>;
 
+struct CountingStringHash {
+    static std::size_t calls;
+    std::size_t operator()(const std::string &value) const {
+        ++calls;
+        return std::hash<std::string>()(value);
+    }
+};
+std::size_t CountingStringHash::calls = 0;
+
+template<bool cacheHash>
+using StringHashTable = tinystl::HashTable<std::string, std::string, CountingStringHash,
+                                           KeyExtractor<std::string>, tinystl::Equal<std::string>,
+                                           tinystl::Alloc, tinystl::PrimeBucketPolicy, cacheHash>;
+
+template<typename BucketPolicy>
+using PolicyHashTable = tinystl::HashTable<int, int, tinystl::Hash<int>,
+                                           KeyExtractor<int>, tinystl::Equal<int>,
+                                           tinystl::Alloc, BucketPolicy>;
+
 TEST(HashTable, constructors) {
     HashTable a;
     ASSERT_TRUE(a.empty());
@@ -89,6 +104,344 @@ TEST(HashTable, maintainers) {
     ASSERT_EQ(*a.begin(), oldValue);
 }
 
+TEST(HashTable, move) {
+    HashTable a;
+    for(int i = 0; i < 100; ++i) {
+        a.insertUnique(i);
+    }
+    HashTable b(tinystl::move(a));
+    ASSERT_TRUE(a.empty());
+    ASSERT_TRUE(a.find(1) == a.end());
+    ASSERT_EQ(b.size(), 100);
+    ASSERT_EQ(*b.find(42), 42);
+
+    a = tinystl::move(b);
+    ASSERT_EQ(a.size(), 100);
+    ASSERT_TRUE(b.empty());
+}
+
+TEST(HashTable, emplace) {
+    HashTable a;
+    for(int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(a.emplaceUnique(i).second);
+    }
+    auto res = a.emplaceUnique(10);
+    ASSERT_FALSE(res.second);
+    ASSERT_EQ(*res.first, 10);
+    ASSERT_EQ(a.size(), 100);
+
+    auto it = a.emplaceEqual(10);
+    ASSERT_EQ(*it, 10);
+    ASSERT_EQ(a.size(), 101);
+    ASSERT_EQ(a.count(10), 2);
+}
+
+TEST(HashTable, resize) {
+    HashTable a;
+    for(int i = 0; i < 10000; ++i) {
+        a.insertUnique(i);
+    }
+    ASSERT_EQ(a.size(), 10000);
+    ASSERT_GE(a.bucketCount(), 10000);
+    for(int i = 0; i < 10000; ++i) {
+        ASSERT_EQ(*a.find(i), i);
+    }
+    ASSERT_EQ(tinystl::distance(a.begin(), a.end()), 10000);
+    ASSERT_EQ(a.findOrInsert(10000), 10000);
+    ASSERT_EQ(a.size(), 10001);
+    a.erase(a.begin(), a.end());
+    ASSERT_TRUE(a.empty());
+}
+
+TEST(HashTable, incrementalRehash) {
+    HashTable a;
+    a.setRehashStep(1);
+    ASSERT_EQ(a.rehashStep(), 1);
+    bool rehashed = false;
+    for(int i = 0; i < 2000; ++i) {
+        a.insertEqual(i);
+        a.insertEqual(i);
+        rehashed = rehashed || a.rehashing();
+        // 迁移过程中所有元素都能被找到和遍历到
+        ASSERT_EQ(a.count(i / 2), 2);
+        ASSERT_EQ(a.count(i), 2);
+        ASSERT_EQ(tinystl::distance(a.begin(), a.end()), a.size());
+    }
+    ASSERT_TRUE(rehashed);
+    ASSERT_TRUE(a.rehashing());
+    auto range = a.equalRange(7);
+    ASSERT_EQ(tinystl::distance(range.first, range.second), 2);
+    ASSERT_EQ(*range.first, 7);
+
+    // 删除不会触发迁移,遍历时删除是安全的
+    for(auto it = a.begin(); it != a.end();) {
+        if(*it % 3 == 0) {
+            a.erase(it++);
+        } else {
+            ++it;
+        }
+    }
+    for(int i = 0; i < 2000; ++i) {
+        ASSERT_EQ(a.count(i), i % 3? 2: 0);
+    }
+    ASSERT_EQ(a.erase(1), 2);
+
+    HashTable b(a);
+    ASSERT_FALSE(b.rehashing());
+    ASSERT_EQ(b.size(), a.size());
+    ASSERT_EQ(b.count(2), 2);
+
+    a.setRehashStep(0);
+    ASSERT_FALSE(a.rehashing());
+    ASSERT_EQ(tinystl::distance(a.begin(), a.end()), a.size());
+    ASSERT_EQ(a.count(2), 2);
+    a.clear();
+    ASSERT_TRUE(a.empty());
+    ASSERT_TRUE(a.begin() == a.end());
+}
+
+template<typename Table>
+std::size_t bucketSizeSum(const Table &table) {
+    std::size_t total = 0;
+    for(std::size_t i = 0; i < table.bucketCount(); ++i) {
+        total += table.elementCountInSpecificBucket(i);
+    }
+    return total;
+}
+
+template<typename Table>
+void testBucketPolicy() {
+    Table a;
+    a.setRehashStep(2);
+    int checks = 0;
+    for(int i = 0; i < 5000; ++i) {
+        a.insertEqual(i * 64);
+        // 迁移过程中还在旧桶中的元素也要计入
+        if(a.rehashing() && i % 97 == 0) {
+            ASSERT_EQ(bucketSizeSum(a), a.size());
+            ASSERT_LT(a.bucket(i * 64), a.bucketCount());
+            ++checks;
+        }
+    }
+    ASSERT_GT(checks, 0);
+    a.insertEqual(64);
+    ASSERT_EQ(a.size(), 5001);
+    for(int i = 0; i < 5000; ++i) {
+        ASSERT_EQ(a.count(i * 64), i == 1? 2: 1);
+        ASSERT_EQ(a.count(i * 64 + 1), 0);
+    }
+    ASSERT_EQ(tinystl::distance(a.begin(), a.end()), 5001);
+    ASSERT_EQ(a.erase(64), 2);
+
+    Table b(a);
+    ASSERT_EQ(b.size(), 4999);
+    ASSERT_EQ(bucketSizeSum(b), b.size());
+}
+
+TEST(HashTable, bucketPolicy) {
+    tinystl::PowerOfTwoBucketPolicy pow2;
+    ASSERT_EQ(pow2.nextBucketCount(100), 128);
+    // 没有桶或只有一个桶时都映射到0
+    for(std::size_t h = 0; h < 1000; ++h) {
+        ASSERT_EQ(pow2.bucketIndex(h * 977), 0);
+    }
+    pow2.reset(1);
+    for(std::size_t h = 0; h < 1000; ++h) {
+        ASSERT_EQ(pow2.bucketIndex(h * 977), 0);
+    }
+    pow2.reset(2);
+    for(std::size_t h = 0; h < 1000; ++h) {
+        ASSERT_LT(pow2.bucketIndex(h * 977), 2);
+    }
+    pow2.reset(128);
+    for(std::size_t h = 0; h < 1000; ++h) {
+        ASSERT_LT(pow2.bucketIndex(h * 977), 128);
+    }
+
+    tinystl::FastModPrimeBucketPolicy fastmod;
+    const std::size_t n = fastmod.nextBucketCount(1000);
+    ASSERT_EQ(n, 1543);
+    fastmod.reset(n);
+    for(std::size_t h = 0; h < 100000; h += 7) {
+        ASSERT_EQ(fastmod.bucketIndex(h), h % n);
+    }
+
+    PolicyHashTable<tinystl::PowerOfTwoBucketPolicy> c(100, tinystl::Equal<int>(),
+                                                       KeyExtractor<int>(), tinystl::Hash<int>());
+    ASSERT_EQ(c.bucketCount(), 128);
+
+    testBucketPolicy<HashTable>();
+    testBucketPolicy<PolicyHashTable<tinystl::FastModPrimeBucketPolicy>>();
+    testBucketPolicy<PolicyHashTable<tinystl::PowerOfTwoBucketPolicy>>();
+}
+
+TEST(HashTable, cachedHash) {
+    StringHashTable<true> a;
+    StringHashTable<false> b;
+    CountingStringHash::calls = 0;
+    for(int i = 0; i < 1000; ++i) {
+        a.insertUnique(std::to_string(i));
+    }
+    // 每次插入只计算一次哈希值,扩容时不再计算
+    ASSERT_EQ(CountingStringHash::calls, 1000);
+    CountingStringHash::calls = 0;
+    for(int i = 0; i < 1000; ++i) {
+        b.insertUnique(std::to_string(i));
+    }
+    ASSERT_GT(CountingStringHash::calls, 1000);
+
+    a.setRehashStep(1);
+    for(int i = 0; i < 1000; ++i) {
+        a.insertEqual(std::to_string(i));
+        a.emplaceUnique(std::to_string(i + 1000));
+    }
+    ASSERT_EQ(a.size(), 3000);
+    ASSERT_EQ(a.count("5"), 2);
+    ASSERT_EQ(a.count("1999"), 1);
+    ASSERT_EQ(a.count("2000"), 0);
+    ASSERT_EQ(tinystl::distance(a.begin(), a.end()), 3000);
+    ASSERT_EQ(a.erase("5"), 2);
+    a.erase(a.find("6"));
+    ASSERT_EQ(a.count("6"), 1);
+
+    StringHashTable<true> c(a);
+    CountingStringHash::calls = 0;
+    c.resize(100000);
+    ASSERT_EQ(CountingStringHash::calls, 0);
+    ASSERT_EQ(c.size(), 2997);
+    ASSERT_EQ(c.count("6"), 1);
+    ASSERT_EQ(*c.find("1500"), "1500");
+}
+
+TEST(HashTable, loadFactor) {
+    HashTable a;
+    ASSERT_EQ(a.maxLoadFactor(), 1.0f);
+    ASSERT_THROW(a.maxLoadFactor(0.0f), std::invalid_argument);
+    a.maxLoadFactor(4.0f);
+    for(int i = 0; i < 1000; ++i) {
+        a.insertUnique(i);
+        ASSERT_LE(a.loadFactor(), 4.0f);
+    }
+    ASSERT_GT(a.loadFactor(), 1.0f);
+    ASSERT_LT(a.bucketCount(), 1000);
+
+    // 调小maxLoadFactor立即扩容
+    a.maxLoadFactor(0.5f);
+    ASSERT_LE(a.loadFactor(), 0.5f);
+    ASSERT_GE(a.bucketCount(), 2000);
+    for(int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(a.count(i), 1);
+    }
+
+    HashTable b;
+    b.maxLoadFactor(2.0f);
+    b.reserve(1000);
+    const std::size_t bucketCount = b.bucketCount();
+    ASSERT_GE(bucketCount, 500);
+    for(int i = 0; i < 1000; ++i) {
+        b.insertUnique(i);
+    }
+    ASSERT_EQ(b.bucketCount(), bucketCount);
+    b.rehash(10000);
+    ASSERT_GE(b.bucketCount(), 10000);
+    b.rehash(10);
+    ASSERT_GE(b.bucketCount(), 10000);
+    ASSERT_EQ(b.count(999), 1);
+
+    HashTable c(b);
+    ASSERT_EQ(c.maxLoadFactor(), 2.0f);
+    HashTable d(tinystl::move(c));
+    c.insertUnique(1);
+    ASSERT_EQ(c.count(1), 1);
+    ASSERT_EQ(d.size(), 1000);
+}
+
+TEST(HashTable, sparseIteration) {
+    HashTable a;
+    a.reserve(1 << 20);
+    ASSERT_TRUE(a.begin() == a.end());
+    for(int i = 0; i < 10; ++i) {
+        a.insertUnique(i * 1000);
+    }
+    int sum = 0;
+    for(auto it = a.begin(); it != a.end(); ++it) {
+        sum += *it;
+    }
+    ASSERT_EQ(sum, 45000);
+
+    // 大量删除后只剩少数几个元素
+    HashTable b;
+    b.setRehashStep(4);
+    for(int i = 0; i < 100000; ++i) {
+        b.insertEqual(i);
+    }
+    for(int i = 0; i < 100000; ++i) {
+        if(i % 10000 != 0) {
+            b.erase(i);
+        }
+    }
+    ASSERT_EQ(b.size(), 10);
+    ASSERT_EQ(tinystl::distance(b.begin(), b.end()), 10);
+    for(auto it = b.begin(); it != b.end();) {
+        ASSERT_EQ(*it % 10000, 0);
+        b.erase(it++);
+    }
+    ASSERT_TRUE(b.empty());
+    ASSERT_TRUE(b.begin() == b.end());
+    b.insertEqual(7);
+    ASSERT_EQ(*b.begin(), 7);
+}
+
+TEST(HashTable, findBatch) {
+    HashTable a;
+    std::vector<int> keys;
+    for(int i = 0; i < 100; ++i) {
+        keys.push_back(i * 3);
+    }
+    HashTable::Iterator iters[100];
+    a.findBatch(keys.data(), keys.size(), iters);
+    for(int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(iters[i] == a.end());
+    }
+
+    // 迁移过程中新旧桶数组都要查找
+    a.setRehashStep(1);
+    for(int i = 0; i < 2000; ++i) {
+        a.insertEqual(i);
+        if(i % 2 == 0) {
+            a.insertEqual(i);
+        }
+    }
+    ASSERT_TRUE(a.rehashing());
+    a.findBatch(keys.data(), keys.size(), iters);
+    for(int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(iters[i] == a.find(keys[i]));
+    }
+
+    const HashTable &b = a;
+    HashTable::ConstIterator citers[100];
+    b.findBatch(keys.data(), keys.size(), citers);
+    for(int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(citers[i] == b.find(keys[i]));
+    }
+
+    // 包括不存在的键
+    const int others[] = {-1, 2000, 1998, 1999, 0};
+    HashTable::SizeType counts[5];
+    b.countBatch(others, 5, counts);
+    ASSERT_EQ(counts[0], 0);
+    ASSERT_EQ(counts[1], 0);
+    ASSERT_EQ(counts[2], 2);
+    ASSERT_EQ(counts[3], 1);
+    ASSERT_EQ(counts[4], 2);
+
+    std::vector<HashTable::SizeType> all(keys.size());
+    b.countBatch(keys.data(), keys.size(), all.data());
+    for(int i = 0; i < 100; ++i) {
+        ASSERT_EQ(all[i], b.count(keys[i]));
+    }
+}
+
 int main(int argc, char *argv[])
 {
     ::testing::InitGoogleTest(&argc, argv);
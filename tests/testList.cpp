@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include <iostream>
+#include <stdexcept>
+#include <string>
 #include "../tinystl/list.h"
 
 TEST(Iterator, convert) {
@@ -244,6 +246,70 @@ TEST(List, sort) {
     }
 }
 
+// 比较第limit次时抛出异常
+struct ThrowingLess {
+    int *count;
+    int limit;
+    bool operator()(int lhs, int rhs) const {
+        if(++*count == limit) {
+            throw std::runtime_error("compare");
+        }
+        return lhs < rhs;
+    }
+};
+
+TEST(List, sortThrows) {
+    tinystl::List<int> l;
+    for(int i = 0; i < 100; ++i) {
+        l.pushBack(i * 37 % 100);
+    }
+    int count = 0;
+    ASSERT_THROW(l.sort(ThrowingLess{&count, 200}), std::runtime_error);
+    // 所有元素都还在链表中
+    ASSERT_EQ(l.size(), 100);
+    int sum = 0;
+    for(auto it = l.begin(); it != l.end(); ++it) {
+        sum += *it;
+    }
+    ASSERT_EQ(sum, 99 * 100 / 2);
+    count = 0;
+    l.sort(ThrowingLess{&count, -1});
+    int expected = 0;
+    for(auto it = l.begin(); it != l.end(); ++it) {
+        ASSERT_EQ(*it, expected++);
+    }
+}
+
+TEST(List, move) {
+    tinystl::List<std::string> a;
+    std::string s("hello");
+    a.pushBack(tinystl::move(s));
+    a.pushFront(std::string("world"));
+    ASSERT_EQ(a.size(), 2);
+    ASSERT_EQ(a.back(), "hello");
+
+    tinystl::List<std::string> b(tinystl::move(a));
+    ASSERT_TRUE(a.empty());
+    ASSERT_EQ(b.size(), 2);
+    ASSERT_EQ(b.front(), "world");
+
+    a = tinystl::move(b);
+    ASSERT_TRUE(b.empty());
+    ASSERT_EQ(a.size(), 2);
+}
+
+TEST(List, emplace) {
+    tinystl::List<std::pair<int, std::string>> a;
+    a.emplaceBack(2, "b");
+    a.emplaceFront(0, "");
+    auto it = a.emplace(++a.cbegin(), 1, std::string(3, 'a'));
+    ASSERT_EQ(it->first, 1);
+    ASSERT_EQ(it->second, "aaa");
+    ASSERT_EQ(a.size(), 3);
+    ASSERT_EQ(a.front().first, 0);
+    ASSERT_EQ(a.back().second, "b");
+}
+
 int main(int argc, char *argv[])
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -1,6 +1,7 @@
 #include "../tinystl/map.h"
 #include "../tinystl/pair.h"
 #include <gtest/gtest.h>
+#include <string>
 
 TEST(Map, simple) {
     tinystl::Map<int, int> m;
@@ -47,6 +48,119 @@ TEST(Map, simple) {
     ASSERT_TRUE(m.empty());
 }
 
+TEST(Map, move) {
+    tinystl::Map<std::string, std::string> m;
+    std::string key("a");
+    m[tinystl::move(key)] = "1";
+    m.insert(tinystl::makePair(std::string("b"), std::string("2")));
+    ASSERT_EQ(m.size(), 2);
+    ASSERT_EQ(m["a"], "1");
+
+    tinystl::Map<std::string, std::string> mm(tinystl::move(m));
+    ASSERT_TRUE(m.empty());
+    ASSERT_EQ(mm.size(), 2);
+    ASSERT_EQ(mm["b"], "2");
+    m = tinystl::move(mm);
+    ASSERT_EQ(m.size(), 2);
+}
+
+namespace {
+    struct NoCopy {
+        NoCopy(int a, int b): value(a + b) {}
+        NoCopy(const NoCopy &) = delete;
+        int value;
+    };
+}
+
+TEST(Map, emplace) {
+    tinystl::Map<int, std::string> m;
+    auto res = m.emplace(1, "one");
+    ASSERT_TRUE(res.second);
+    ASSERT_EQ(res.first->second, "one");
+    res = m.emplace(1, "uno");
+    ASSERT_FALSE(res.second);
+    ASSERT_EQ(res.first->second, "one");
+
+    auto it = m.emplaceHint(m.end(), 3, "three");
+    ASSERT_EQ(it->first, 3);
+    it = m.emplaceHint(it, 2, "two");
+    ASSERT_EQ(it->first, 2);
+    ASSERT_EQ(m.size(), 3);
+
+    res = m.tryEmplace(4, 3, 'x');
+    ASSERT_TRUE(res.second);
+    ASSERT_EQ(m[4], "xxx");
+    res = m.tryEmplace(4, 3, 'y');
+    ASSERT_FALSE(res.second);
+    ASSERT_EQ(m[4], "xxx");
+
+    // MappedType不能复制时也可以原地构造
+    tinystl::Map<int, NoCopy> n;
+    ASSERT_TRUE(n.tryEmplace(1, 2, 3).second);
+    ASSERT_FALSE(n.tryEmplace(1, 4, 5).second);
+    ASSERT_EQ(n.at(1).value, 5);
+}
+
+// 记录从C风格字符串构造的次数
+struct Name {
+    static int constructed;
+    std::string value;
+
+    Name(const char *str): value(str) { ++constructed; }
+};
+int Name::constructed = 0;
+
+bool operator<(const Name &lhs, const Name &rhs) { return lhs.value < rhs.value; }
+bool operator<(const Name &lhs, const char *rhs) { return lhs.value < rhs; }
+bool operator<(const char *lhs, const Name &rhs) { return lhs < rhs.value; }
+
+TEST(Map, rangeConstructor) {
+    tinystl::Pair<int, int> sorted[] = {
+        tinystl::makePair(1, 1), tinystl::makePair(2, 4), tinystl::makePair(2, 5),
+        tinystl::makePair(3, 9), tinystl::makePair(5, 25)
+    };
+    tinystl::Map<int, int> m(std::begin(sorted), std::end(sorted));
+    ASSERT_EQ(m.size(), 4);
+    ASSERT_EQ(m[2], 4);
+    ASSERT_EQ(m.lowerBound(4)->first, 5);
+    ASSERT_EQ(m.upperBound(3)->first, 5);
+
+    tinystl::Pair<int, int> unsorted[] = {
+        tinystl::makePair(3, 9), tinystl::makePair(1, 1), tinystl::makePair(2, 4)
+    };
+    tinystl::Map<int, int, tinystl::Greater<int>> g(std::begin(unsorted), std::end(unsorted));
+    ASSERT_EQ(g.begin()->first, 3);
+    ASSERT_EQ(g.lowerBound(2)->first, 2);
+}
+
+TEST(Map, transparentLookup) {
+    tinystl::Map<Name, int, tinystl::Less<void>> m;
+    m.emplace("b", 2);
+    m.emplace("d", 4);
+    m.emplace("f", 6);
+    Name::constructed = 0;
+    ASSERT_EQ(m.find("d")->second, 4);
+    ASSERT_TRUE(m.find("c") == m.end());
+    ASSERT_EQ(m.count("f"), 1);
+    ASSERT_EQ(m.count("a"), 0);
+    auto range = m.equalRange("b");
+    ASSERT_EQ(range.first->second, 2);
+    ASSERT_EQ(tinystl::distance(range.first, range.second), 1);
+    ASSERT_EQ(m.lowerBound("c")->second, 4);
+    ASSERT_EQ(m.upperBound("d")->second, 6);
+    ASSERT_TRUE(m.upperBound("f") == m.end());
+    const auto &cm = m;
+    ASSERT_EQ(cm.find("f")->second, 6);
+    ASSERT_EQ(cm.lowerBound("a")->second, 2);
+    ASSERT_EQ(cm.upperBound("b")->second, 4);
+    ASSERT_EQ(Name::constructed, 0);
+
+    // 普通的比较函数仍然只接受键
+    tinystl::Map<std::string, int> n;
+    n["hello"] = 1;
+    ASSERT_EQ(n.find("hello")->second, 1);
+}
+
 int main(int argc, char *argv[])
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "../tinystl/objectpool.h"
+#include "../tinystl/algobase.h"
+#include "../tinystl/list.h"
+#include "../tinystl/rbtree.h"
+#include "../tinystl/hashtable.h"
+
+struct Identity {
+    const int& operator()(const int &x) const {
+        return x;
+    }
+};
+
+struct IntHash {
+    std::size_t operator()(int x) const {
+        return x;
+    }
+};
+
+struct Node {
+    Node *left;
+    Node *right;
+    int value;
+};
+
+TEST(ObjectPool, allocate) {
+    tinystl::ObjectPool<Node> pool;
+    ASSERT_EQ(tinystl::ObjectPool<Node>::slotSize(), sizeof(Node));
+    std::vector<Node *> nodes;
+    for(int i = 0; i < 10000; ++i) {
+        Node *node = pool.allocate();
+        node->value = i;
+        nodes.push_back(node);
+    }
+    for(int i = 0; i < 10000; ++i) {
+        ASSERT_EQ(nodes[i]->value, i);
+    }
+    std::size_t slabCount = pool.slabCount();
+    ASSERT_GT(slabCount, 0);
+
+    // 后释放的先复用
+    pool.deallocate(nodes[0]);
+    pool.deallocate(nodes[1]);
+    ASSERT_EQ(pool.freeCount(), 2);
+    ASSERT_EQ(pool.allocate(), nodes[1]);
+    ASSERT_EQ(pool.allocate(), nodes[0]);
+    ASSERT_EQ(pool.freeCount(), 0);
+    ASSERT_EQ(pool.slabCount(), slabCount);
+}
+
+TEST(ObjectPool, cacheLineAligned) {
+    tinystl::ObjectPool<Node, tinystl::CACHE_LINE_SIZE> pool;
+    for(int i = 0; i < 1000; ++i) {
+        Node *node = pool.allocate();
+        ASSERT_EQ(reinterpret_cast<std::size_t>(node) % tinystl::CACHE_LINE_SIZE, 0);
+    }
+}
+
+TEST(PoolAllocator, containers) {
+    tinystl::List<int, tinystl::PoolAllocator> l;
+    tinystl::RBTree<int, int, Identity, tinystl::Less<int>, tinystl::PoolAllocator> t;
+    tinystl::HashTable<int, int, IntHash, Identity,
+                       tinystl::Equal<int>, tinystl::PoolAllocator> h;
+    for(int round = 0; round < 3; ++round) {
+        for(int i = 0; i < 1000; ++i) {
+            l.pushBack(i);
+            t.insertUnique(i);
+            h.insertUnique(i);
+        }
+        ASSERT_EQ(l.size(), 1000);
+        ASSERT_EQ(t.size(), 1000);
+        ASSERT_EQ(h.size(), 1000);
+        ASSERT_TRUE(t.rbVerify());
+        for(int i = 0; i < 1000; ++i) {
+            ASSERT_EQ(*t.find(i), i);
+            ASSERT_EQ(*h.find(i), i);
+        }
+        l.clear();
+        t.clear();
+        h.clear();
+    }
+    ASSERT_GT(tinystl::PoolAllocator::pool<tinystl::__RBTreeNode<int>>().freeCount(), 0);
+}
+
+TEST(PoolAllocator, multiThreads) {
+    using Alloc = tinystl::PoolAlloc<1, true>;
+    auto work = []() {
+        tinystl::List<int, Alloc> l;
+        for(int round = 0; round < 10; ++round) {
+            for(int i = 0; i < 1000; ++i) {
+                l.pushBack(i);
+            }
+            int i = 0;
+            for(auto value: l) {
+                ASSERT_EQ(value, i++);
+            }
+            l.clear();
+        }
+    };
+    std::vector<std::thread> threads;
+    for(int i = 0; i < 4; ++i) {
+        threads.emplace_back(work);
+    }
+    for(auto &thread: threads) {
+        thread.join();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
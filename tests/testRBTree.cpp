@@ -11,6 +11,22 @@ struct KeyOfValue {
 };
 
 using RBTree = tinystl::RBTree<int, int, KeyOfValue, tinystl::Less<int>>;
+using OSTree = tinystl::RBTree<int, int, KeyOfValue, tinystl::Less<int>,
+                               tinystl::Alloc, true>;
+
+// 和逐个遍历得到的位置比较
+static void checkOrderStatistics(const OSTree &t) {
+    ASSERT_TRUE(t.rbVerify());
+    OSTree::SizeType i = 0;
+    for(auto it = t.cbegin(); it != t.cend(); ++it, ++i) {
+        ASSERT_EQ(t.index(it), i);
+        ASSERT_TRUE(t.select(i) == it);
+        ASSERT_EQ(t.rank(*it), t.index(t.lowerBound(*it)));
+    }
+    ASSERT_EQ(i, t.size());
+    ASSERT_EQ(t.index(t.cend()), t.size());
+    ASSERT_TRUE(t.select(t.size()) == t.cend());
+}
 
 TEST(RBTree, constructors) {
     RBTree t;
@@ -176,6 +192,198 @@ TEST(RBTree, operators) {
     ASSERT_TRUE(t.empty());
 }
 
+TEST(RBTree, bulkBuild) {
+    // 各种大小的有序输入,包括满二叉树和最后一层只有一个结点的情况
+    for(int n = 0; n <= 130; ++n) {
+        std::vector<int> data;
+        for(int i = 0; i < n; ++i) {
+            data.push_back(i * 2);
+        }
+        RBTree t;
+        t.insertUnique(data.data(), data.data() + n);
+        ASSERT_TRUE(t.rbVerify());
+        ASSERT_EQ(t.size(), n);
+        int expected = 0;
+        for(auto it = t.begin(); it != t.end(); ++it, expected += 2) {
+            ASSERT_EQ(*it, expected);
+        }
+        // 反向遍历用到parent指针
+        for(auto it = t.rbegin(); it != t.rend(); ++it) {
+            expected -= 2;
+            ASSERT_EQ(*it, expected);
+        }
+        t.insertUnique(1);
+        t.erase(0);
+        ASSERT_TRUE(t.rbVerify());
+    }
+
+    // 有序但有重复
+    int dup[] = {1, 1, 2, 3, 3, 3, 4};
+    RBTree unique;
+    unique.insertUnique(std::begin(dup), std::end(dup));
+    ASSERT_TRUE(unique.rbVerify());
+    ASSERT_EQ(unique.size(), 4);
+    RBTree equal;
+    equal.insertEqual(std::begin(dup), std::end(dup));
+    ASSERT_TRUE(equal.rbVerify());
+    ASSERT_EQ(equal.size(), 7);
+    ASSERT_EQ(equal.count(3), 3);
+
+    // 中途出现无序的元素时退化为逐个插入
+    int unsorted[] = {1, 3, 5, 2, 9, 3, 0, 7};
+    RBTree t;
+    t.insertUnique(std::begin(unsorted), std::end(unsorted));
+    ASSERT_TRUE(t.rbVerify());
+    ASSERT_EQ(t.size(), 7);
+    int last = -1;
+    for(auto it = t.begin(); it != t.end(); ++it) {
+        ASSERT_LT(last, *it);
+        last = *it;
+    }
+    RBTree t2;
+    t2.insertEqual(std::begin(unsorted), std::end(unsorted));
+    ASSERT_TRUE(t2.rbVerify());
+    ASSERT_EQ(t2.size(), 8);
+    ASSERT_EQ(t2.count(3), 2);
+
+    // 非空树上的区间插入
+    t.insertUnique(std::begin(dup), std::end(dup));
+    ASSERT_TRUE(t.rbVerify());
+    ASSERT_EQ(t.size(), 8);
+}
+
+TEST(RBTree, splitJoin) {
+    const int n = 300;
+    RBTree t;
+    for(int i = 0; i < n; ++i) {
+        t.insertUnique(i * 2);
+    }
+    // 在每个位置分开再连接回去
+    for(int key = -1; key <= n * 2 + 1; key += 7) {
+        RBTree right;
+        right.insertUnique(12345);
+        t.split(key, right);
+        ASSERT_TRUE(t.rbVerify());
+        ASSERT_TRUE(right.rbVerify());
+        const int expectedLeft = key <= 0? 0: tinystl::min((key + 1) / 2, n);
+        ASSERT_EQ(t.size(), expectedLeft);
+        ASSERT_EQ(right.size(), n - expectedLeft);
+        ASSERT_EQ(tinystl::distance(t.begin(), t.end()), expectedLeft);
+        ASSERT_EQ(tinystl::distance(right.begin(), right.end()), n - expectedLeft);
+        if(!t.empty()) {
+            ASSERT_LT(*t.rbegin(), key);
+        }
+        if(!right.empty()) {
+            ASSERT_GE(*right.begin(), key);
+        }
+        t.join(right);
+        ASSERT_TRUE(right.empty());
+        ASSERT_TRUE(right.rbVerify());
+        ASSERT_TRUE(t.rbVerify());
+        ASSERT_EQ(t.size(), n);
+        int expected = 0;
+        for(auto it = t.begin(); it != t.end(); ++it, expected += 2) {
+            ASSERT_EQ(*it, expected);
+        }
+    }
+
+    // 黑高相差很多的两棵树
+    RBTree small, large;
+    small.insertUnique(-5);
+    for(int i = 0; i < 1000; ++i) {
+        large.insertUnique(i);
+    }
+    small.join(-1, large);
+    ASSERT_TRUE(small.rbVerify());
+    ASSERT_EQ(small.size(), 1002);
+    ASSERT_EQ(*small.begin(), -5);
+    ASSERT_EQ(*small.rbegin(), 999);
+    for(int i = 1000; i < 1010; ++i) {
+        large.insertUnique(i);
+    }
+    small.join(large);
+    ASSERT_TRUE(small.rbVerify());
+    ASSERT_EQ(small.size(), 1012);
+    ASSERT_EQ(*small.rbegin(), 1009);
+
+    RBTree empty;
+    empty.join(3, large);
+    ASSERT_TRUE(empty.rbVerify());
+    ASSERT_EQ(empty.size(), 1);
+    ASSERT_THROW(empty.join(2, large), std::invalid_argument);
+    large.insertUnique(0);
+    ASSERT_THROW(empty.join(large), std::invalid_argument);
+    ASSERT_EQ(empty.size(), 1);
+    ASSERT_EQ(large.size(), 1);
+
+    // 相等的键都分到右边
+    RBTree multi;
+    for(int i = 0; i < 50; ++i) {
+        multi.insertEqual(i % 5);
+    }
+    RBTree rest;
+    multi.split(3, rest);
+    ASSERT_TRUE(multi.rbVerify());
+    ASSERT_TRUE(rest.rbVerify());
+    ASSERT_EQ(multi.size(), 30);
+    ASSERT_EQ(rest.size(), 20);
+    ASSERT_EQ(rest.count(3), 10);
+    multi.join(3, rest);
+    ASSERT_TRUE(multi.rbVerify());
+    ASSERT_EQ(multi.count(3), 11);
+}
+
+TEST(RBTree, orderStatistics) {
+    OSTree t;
+    for(int i = 0; i < 200; ++i) {
+        t.insertEqual(i * 37 % 100);
+    }
+    checkOrderStatistics(t);
+    ASSERT_EQ(t.rank(-1), 0);
+    ASSERT_EQ(t.rank(50), 100);
+    ASSERT_EQ(t.rank(1000), 200);
+    ASSERT_EQ(*t.select(0), 0);
+    ASSERT_EQ(*t.select(199), 99);
+    ASSERT_EQ(t.distance(t.lowerBound(10), t.upperBound(20)), 22);
+    ASSERT_EQ(t.distance(t.upperBound(20), t.lowerBound(10)), -22);
+
+    for(int i = 0; i < 200; i += 3) {
+        t.erase(i % 100);
+        checkOrderStatistics(t);
+    }
+    t.insertUnique(t.begin(), -3);
+    checkOrderStatistics(t);
+
+    OSTree copy(t);
+    checkOrderStatistics(copy);
+
+    int data[500];
+    for(int i = 0; i < 500; ++i) {
+        data[i] = i;
+    }
+    OSTree built;
+    built.insertUnique(data, data + 500);
+    checkOrderStatistics(built);
+
+    // 分开后两边的元素个数由根结点得到
+    OSTree right;
+    built.split(123, right);
+    ASSERT_EQ(built.size(), 123);
+    ASSERT_EQ(right.size(), 377);
+    checkOrderStatistics(built);
+    checkOrderStatistics(right);
+    ASSERT_EQ(*right.select(0), 123);
+    built.join(right);
+    checkOrderStatistics(built);
+    ASSERT_EQ(built.size(), 500);
+    OSTree small;
+    small.insertUnique(-10);
+    small.join(-5, built);
+    checkOrderStatistics(small);
+    ASSERT_EQ(*small.select(2), 0);
+    ASSERT_EQ(small.rank(0), 2);
+}
+
 int main(int argc, char *argv[])
 {
     ::testing::InitGoogleTest(&argc, argv);
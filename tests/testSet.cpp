@@ -1,5 +1,6 @@
 #include "../tinystl/set.h"
 #include <gtest/gtest.h>
+#include <string>
 
 TEST(Set, constructors) {
     tinystl::Set<int> s;
@@ -122,6 +123,91 @@ TEST(Set, equalOperator) {
     ASSERT_TRUE(s2 <= s);
 }
 
+TEST(Set, emplace) {
+    tinystl::Set<std::string> s;
+    ASSERT_TRUE(s.emplace(3, 'a').second);
+    ASSERT_FALSE(s.emplace("aaa").second);
+    auto it = s.emplaceHint(s.cend(), "b");
+    ASSERT_EQ(*it, "b");
+    it = s.emplaceHint(s.cbegin(), "a");
+    ASSERT_EQ(*it, "a");
+    ASSERT_EQ(s.size(), 3);
+    ASSERT_EQ(*s.begin(), "a");
+}
+
+// 记录从C风格字符串构造的次数
+struct Name {
+    static int constructed;
+    std::string value;
+
+    Name(const char *str): value(str) { ++constructed; }
+};
+int Name::constructed = 0;
+
+bool operator<(const Name &lhs, const Name &rhs) { return lhs.value < rhs.value; }
+bool operator<(const Name &lhs, const char *rhs) { return lhs.value < rhs; }
+bool operator<(const char *lhs, const Name &rhs) { return lhs < rhs.value; }
+
+TEST(Set, transparentLookup) {
+    tinystl::Set<Name, tinystl::Less<void>> s;
+    s.emplace("b");
+    s.emplace("d");
+    s.emplace("f");
+    Name::constructed = 0;
+    ASSERT_EQ(s.find("d")->value, "d");
+    ASSERT_TRUE(s.find("c") == s.end());
+    ASSERT_EQ(s.count("b"), 1);
+    ASSERT_EQ(s.lowerBound("c")->value, "d");
+    ASSERT_EQ(s.upperBound("d")->value, "f");
+    ASSERT_TRUE(s.upperBound("f") == s.end());
+    const auto &cs = s;
+    ASSERT_EQ(cs.lowerBound("a")->value, "b");
+    ASSERT_EQ(cs.upperBound("b")->value, "d");
+    auto range = cs.equalRange("f");
+    ASSERT_EQ(tinystl::distance(range.first, range.second), 1);
+    ASSERT_EQ(Name::constructed, 0);
+}
+
+TEST(Set, splitJoin) {
+    int data[] = {1, 3, 5, 7, 9, 11};
+    tinystl::Set<int> s(std::begin(data), std::end(data));
+    tinystl::Set<int> right;
+    s.split(6, right);
+    ASSERT_EQ(s.size(), 3);
+    ASSERT_EQ(right.size(), 3);
+    ASSERT_EQ(*s.rbegin(), 5);
+    ASSERT_EQ(*right.begin(), 7);
+
+    // 键有重叠时不能连接
+    tinystl::Set<int> overlap;
+    overlap.insert(5);
+    ASSERT_THROW(s.join(overlap), std::invalid_argument);
+    ASSERT_EQ(overlap.size(), 1);
+
+    s.join(right);
+    ASSERT_TRUE(right.empty());
+    ASSERT_EQ(s.size(), 6);
+    int i = 0;
+    for(auto it = s.begin(); it != s.end(); ++it) {
+        ASSERT_EQ(*it, data[i++]);
+    }
+}
+
+TEST(Set, orderStatistics) {
+    tinystl::Set<int, tinystl::Less<int>, tinystl::Alloc, true> s;
+    for(int i = 0; i < 100; ++i) {
+        s.insert(i * 3);
+    }
+    ASSERT_EQ(*s.select(10), 30);
+    ASSERT_TRUE(s.select(100) == s.end());
+    ASSERT_EQ(s.rank(31), 11);
+    ASSERT_EQ(s.index(s.find(60)), 20);
+    ASSERT_EQ(s.distance(s.find(3), s.find(30)), 9);
+    s.erase(0);
+    ASSERT_EQ(*s.select(0), 3);
+    ASSERT_EQ(s.rank(31), 10);
+}
+
 int main(int argc, char *argv[])
 {
     ::testing::InitGoogleTest(&argc, argv);
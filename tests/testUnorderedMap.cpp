@@ -0,0 +1,114 @@
+#include "../tinystl/unorderedmap.h"
+#include "../tinystl/pair.h"
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+
+TEST(UnorderedMap, simple) {
+    tinystl::UnorderedMap<int, int> m;
+    ASSERT_TRUE(m.empty());
+    ASSERT_EQ(m.size(), 0);
+    ASSERT_TRUE(m.find(1) == m.end());
+
+    for(int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(m.insert(tinystl::makePair(i, i * 2)).second);
+    }
+    ASSERT_FALSE(m.insert(tinystl::makePair(1, 0)).second);
+    ASSERT_EQ(m.size(), 1000);
+    ASSERT_EQ(m.find(10)->second, 20);
+    ASSERT_EQ(m.at(999), 1998);
+    ASSERT_THROW(m.at(1000), std::out_of_range);
+    ASSERT_EQ(tinystl::distance(m.begin(), m.end()), 1000);
+
+    m[5] = -5;
+    ASSERT_EQ(m.at(5), -5);
+    ASSERT_EQ(m[2000], 0);
+    ASSERT_EQ(m.size(), 1001);
+
+    ASSERT_EQ(m.erase(2000), 1);
+    ASSERT_EQ(m.erase(2000), 0);
+    m.erase(m.find(0));
+    ASSERT_EQ(m.count(0), 0);
+    ASSERT_EQ(m.size(), 999);
+
+    auto r = m.equalRange(7);
+    ASSERT_EQ(tinystl::distance(r.first, r.second), 1);
+    ASSERT_EQ(r.first->second, 14);
+
+    tinystl::UnorderedMap<int, int> mm(m.begin(), m.end());
+    ASSERT_TRUE(mm == m);
+    mm[1] = 0;
+    ASSERT_TRUE(mm != m);
+    mm.swap(m);
+    ASSERT_EQ(m[1], 0);
+    m.clear();
+    ASSERT_TRUE(m.empty());
+}
+
+TEST(UnorderedMap, buckets) {
+    tinystl::UnorderedMap<std::string, int> m(100);
+    ASSERT_GE(m.bucketCount(), 100);
+    ASSERT_EQ(m.loadFactor(), 0.0f);
+    m.reserve(5000);
+    const std::size_t bucketCount = m.bucketCount();
+    ASSERT_GE(bucketCount, 5000);
+    for(int i = 0; i < 5000; ++i) {
+        m.emplace(std::to_string(i), i);
+    }
+    ASSERT_EQ(m.bucketCount(), bucketCount);
+    ASSERT_LE(m.loadFactor(), 1.0f);
+
+    std::size_t total = 0;
+    for(std::size_t i = 0; i < m.bucketCount(); ++i) {
+        total += m.bucketSize(i);
+    }
+    ASSERT_EQ(total, m.size());
+    const std::size_t bucketNo = m.bucket("42");
+    ASSERT_LT(bucketNo, m.bucketCount());
+    ASSERT_GE(m.bucketSize(bucketNo), 1);
+    ASSERT_EQ(m.hashFunction()("42"), tinystl::Hash<std::string>()("42"));
+    ASSERT_TRUE(m.keyEq()("a", "a"));
+
+    m.maxLoadFactor(0.25f);
+    ASSERT_EQ(m.maxLoadFactor(), 0.25f);
+    ASSERT_LE(m.loadFactor(), 0.25f);
+    m.rehash(100000);
+    ASSERT_GE(m.bucketCount(), 100000);
+    ASSERT_EQ(m.at("4999"), 4999);
+}
+
+TEST(UnorderedMap, emplace) {
+    tinystl::UnorderedMap<std::string, std::string> m;
+    ASSERT_TRUE(m.tryEmplace("a", 3, 'x').second);
+    ASSERT_FALSE(m.tryEmplace("a", "y").second);
+    ASSERT_EQ(m["a"], "xxx");
+    std::string key("b");
+    m[tinystl::move(key)] = "b";
+    ASSERT_TRUE(key.empty());
+    ASSERT_EQ(m.at("b"), "b");
+    ASSERT_TRUE(m.emplace("c", "c").second);
+    ASSERT_EQ(m.size(), 3);
+}
+
+TEST(UnorderedMap, transparentLookup) {
+    tinystl::UnorderedMap<std::string, int, tinystl::Hash<std::string>, tinystl::Equal<void>> m;
+    m["alpha"] = 1;
+    m["beta"] = 2;
+    const char *key = "beta";
+    ASSERT_EQ(m.find(key)->second, 2);
+    ASSERT_TRUE(m.find("gamma") == m.end());
+    ASSERT_EQ(m.count("alpha"), 1);
+    ASSERT_EQ(m.count("gamma"), 0);
+    auto range = m.equalRange("alpha");
+    ASSERT_EQ(tinystl::distance(range.first, range.second), 1);
+    ASSERT_EQ(range.first->second, 1);
+    const auto &cm = m;
+    ASSERT_EQ(cm.find("alpha")->second, 1);
+    ASSERT_EQ(tinystl::Hash<std::string>()("beta"), tinystl::Hash<std::string>()(std::string("beta")));
+}
+
+int main(int argc, char *argv[])
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,53 @@
+#include "../tinystl/unorderedmultimap.h"
+#include "../tinystl/pair.h"
+#include <gtest/gtest.h>
+
+TEST(UnorderedMultiMap, simple) {
+    tinystl::UnorderedMultiMap<int, int> m;
+    ASSERT_TRUE(m.empty());
+
+    for(int i = 0; i < 300; ++i) {
+        m.insert(tinystl::makePair(i % 100, i));
+    }
+    ASSERT_EQ(m.size(), 300);
+    ASSERT_EQ(m.count(5), 3);
+    ASSERT_EQ(m.count(100), 0);
+
+    auto r = m.equalRange(7);
+    ASSERT_EQ(tinystl::distance(r.first, r.second), 3);
+    int sum = 0;
+    for(auto it = r.first; it != r.second; ++it) {
+        ASSERT_EQ(it->first, 7);
+        sum += it->second;
+    }
+    ASSERT_EQ(sum, 7 + 107 + 207);
+
+    auto it = m.emplace(7, 307);
+    ASSERT_EQ(it->second, 307);
+    ASSERT_EQ(m.erase(7), 4);
+    m.erase(m.find(8));
+    ASSERT_EQ(m.count(8), 2);
+
+    // 相等的键顺序不同也相等
+    tinystl::UnorderedMultiMap<int, int> a, b;
+    a.insert(tinystl::makePair(1, 1));
+    a.insert(tinystl::makePair(1, 2));
+    b.insert(tinystl::makePair(1, 2));
+    b.insert(tinystl::makePair(1, 1));
+    ASSERT_TRUE(a == b);
+    b.insert(tinystl::makePair(1, 1));
+    a.insert(tinystl::makePair(1, 2));
+    ASSERT_TRUE(a != b);
+
+    tinystl::UnorderedMultiMap<int, int> mm(m.begin(), m.end(), 1000);
+    ASSERT_GE(mm.bucketCount(), 1000);
+    ASSERT_TRUE(mm == m);
+    m.swap(b);
+    ASSERT_EQ(m.size(), 3);
+}
+
+int main(int argc, char *argv[])
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,35 @@
+#include "../tinystl/unorderedmultiset.h"
+#include <gtest/gtest.h>
+
+TEST(UnorderedMultiSet, simple) {
+    tinystl::UnorderedMultiSet<int> s;
+    ASSERT_TRUE(s.empty());
+    for(int i = 0; i < 500; ++i) {
+        s.insert(i % 50);
+    }
+    ASSERT_EQ(s.size(), 500);
+    ASSERT_EQ(s.count(7), 10);
+    ASSERT_EQ(*s.emplace(7), 7);
+    auto r = s.equalRange(7);
+    ASSERT_EQ(tinystl::distance(r.first, r.second), 11);
+    ASSERT_EQ(s.erase(7), 11);
+    s.erase(s.find(8));
+    ASSERT_EQ(s.count(8), 9);
+
+    int data[] = {1, 2, 1, 3, 1};
+    int reversed[] = {1, 3, 1, 2, 1};
+    tinystl::UnorderedMultiSet<int> a(std::begin(data), std::end(data));
+    tinystl::UnorderedMultiSet<int> b(std::begin(reversed), std::end(reversed));
+    ASSERT_EQ(a.size(), 5);
+    ASSERT_TRUE(a == b);
+    b.insert(2);
+    ASSERT_TRUE(a != b);
+    a.swap(b);
+    ASSERT_EQ(a.count(2), 2);
+}
+
+int main(int argc, char *argv[])
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
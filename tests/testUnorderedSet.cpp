@@ -0,0 +1,55 @@
+#include "../tinystl/unorderedset.h"
+#include <gtest/gtest.h>
+#include <string>
+
+TEST(UnorderedSet, simple) {
+    tinystl::UnorderedSet<int> s;
+    ASSERT_TRUE(s.empty());
+    for(int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(s.insert(i).second);
+    }
+    auto res = s.insert(3);
+    ASSERT_FALSE(res.second);
+    ASSERT_EQ(*res.first, 3);
+    ASSERT_EQ(s.size(), 1000);
+    ASSERT_EQ(s.count(999), 1);
+    ASSERT_EQ(s.count(1000), 0);
+    ASSERT_EQ(tinystl::distance(s.begin(), s.end()), 1000);
+
+    ASSERT_EQ(s.erase(1), 1);
+    s.erase(s.find(2));
+    ASSERT_EQ(s.size(), 998);
+    ASSERT_TRUE(s.find(2) == s.end());
+
+    int data[] = {5, 1, 5, 2};
+    tinystl::UnorderedSet<int> t(std::begin(data), std::end(data));
+    ASSERT_EQ(t.size(), 3);
+    tinystl::UnorderedSet<int> u;
+    u.insert(2);
+    u.insert(5);
+    u.insert(1);
+    ASSERT_TRUE(t == u);
+    u.erase(u.begin(), u.end());
+    ASSERT_TRUE(u.empty());
+    ASSERT_TRUE(t != u);
+}
+
+TEST(UnorderedSet, strings) {
+    tinystl::UnorderedSet<std::string> s;
+    s.reserve(100);
+    ASSERT_GE(s.bucketCount(), 100);
+    ASSERT_TRUE(s.emplace(3, 'a').second);
+    ASSERT_FALSE(s.emplace("aaa").second);
+    std::string b("b");
+    s.insert(tinystl::move(b));
+    ASSERT_TRUE(b.empty());
+    ASSERT_EQ(s.size(), 2);
+    ASSERT_GE(s.bucketSize(s.bucket("b")), 1);
+    ASSERT_GT(s.loadFactor(), 0.0f);
+}
+
+int main(int argc, char *argv[])
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <sys/select.h>
 #include <vector>
+#include <string>
 #include "../tinystl/vector.h"
 #include "../tinystl/algobase.h"
 #include "../tinystl/iteratortraits.h"
@@ -244,6 +245,203 @@ TEST(vector, compare) {
     ASSERT_FALSE(a >= b);
 }
 
+namespace {
+    // 计数复制和析构的次数,不能按字节搬移
+    struct Counted {
+        static int copies;
+        static int live;
+        int value;
+        Counted(int value = 0): value(value) { ++live; }
+        Counted(const Counted &other): value(other.value) { ++copies; ++live; }
+        ~Counted() { --live; }
+    };
+
+    int Counted::copies = 0;
+    int Counted::live = 0;
+}
+
+TEST(vector, relocatable) {
+    ASSERT_TRUE((std::is_same<tinystl::IsRelocatable<int>::Relocatable, tinystl::TrueType>::value));
+    ASSERT_TRUE((std::is_same<tinystl::IsRelocatable<Counted>::Relocatable, tinystl::FalseType>::value));
+    ASSERT_TRUE((std::is_same<tinystl::IsRelocatable<tinystl::Vector<Counted>>::Relocatable,
+                              tinystl::TrueType>::value));
+}
+
+TEST(vector, reserve) {
+    tinystl::Vector<int> a;
+    a.reserve(100);
+    ASSERT_EQ(a.size(), 0);
+    ASSERT_EQ(a.capacity(), 100);
+    for(int i = 0; i < 100; ++i) {
+        a.pushBack(i);
+    }
+    ASSERT_EQ(a.capacity(), 100);
+    a.reserve(1000);
+    ASSERT_EQ(a.capacity(), 1000);
+    for(int i = 0; i < 100; ++i) {
+        ASSERT_EQ(a[i], i);
+    }
+
+    Counted::copies = 0;
+    tinystl::Vector<Counted> b(10, Counted(1));
+    Counted::copies = 0;
+    b.reserve(20);
+    ASSERT_EQ(Counted::copies, 10);
+}
+
+TEST(vector, relocateGrowth) {
+    tinystl::Vector<int> a;
+    std::vector<int> b;
+    for(int i = 0; i < 10000; ++i) {
+        a.pushBack(i);
+        b.push_back(i);
+    }
+    a.insert(a.begin() + 5, 3, -1);
+    b.insert(b.begin() + 5, 3, -1);
+    std::vector<int> c(b);
+    a.insert(a.begin(), c.begin(), c.end());
+    b.insert(b.begin(), c.begin(), c.end());
+    ASSERT_EQ(a.size(), b.size());
+    ASSERT_TRUE(tinystl::equal(a.cbegin(), a.cend(), b.cbegin()));
+
+    // 元素本身是Vector时,扩容只搬移指针
+    tinystl::Vector<tinystl::Vector<int>> d;
+    for(int i = 0; i < 1000; ++i) {
+        d.pushBack(tinystl::Vector<int>(i % 10, i));
+    }
+    for(int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(d[i].size(), i % 10);
+        for(int j = 0; j < i % 10; ++j) {
+            ASSERT_EQ(d[i][j], i);
+        }
+    }
+}
+
+TEST(vector, pushBackAliasing) {
+    tinystl::Vector<int> a(4, 7);
+    ASSERT_EQ(a.size(), a.capacity());
+    a.pushBack(a[0]);
+    ASSERT_EQ(a.size(), 5);
+    ASSERT_EQ(a[4], 7);
+
+    a.insert(a.begin(), a[4]);
+    ASSERT_EQ(a[0], 7);
+
+    tinystl::Vector<tinystl::Vector<int>> b(1, tinystl::Vector<int>(3, 5));
+    b.pushBack(b[0]);
+    ASSERT_EQ(b[1].size(), 3);
+    ASSERT_EQ(b[1][2], 5);
+}
+
+TEST(vector, nonRelocatableGrowth) {
+    Counted::live = 0;
+    {
+        tinystl::Vector<Counted> a;
+        for(int i = 0; i < 100; ++i) {
+            a.pushBack(Counted(i));
+        }
+        a.insert(a.begin() + 1, 50, Counted(-1));
+        ASSERT_EQ(a.size(), 150);
+        ASSERT_EQ(a[0].value, 0);
+        ASSERT_EQ(a[1].value, -1);
+        ASSERT_EQ(a[51].value, 1);
+        ASSERT_EQ(Counted::live, 150);
+    }
+    ASSERT_EQ(Counted::live, 0);
+}
+
+namespace {
+    // 计数复制和移动的次数,移动构造不抛出异常
+    struct Movable {
+        static int copies;
+        static int moves;
+        int value;
+        Movable(int value = 0): value(value) {}
+        Movable(const Movable &other): value(other.value) { ++copies; }
+        Movable(Movable &&other) noexcept: value(other.value) { other.value = -1; ++moves; }
+        Movable& operator=(const Movable &other) { value = other.value; ++copies; return *this; }
+        Movable& operator=(Movable &&other) noexcept { value = other.value; other.value = -1; ++moves; return *this; }
+    };
+
+    int Movable::copies = 0;
+    int Movable::moves = 0;
+}
+
+TEST(vector, move) {
+    tinystl::Vector<int> a(10, 3);
+    tinystl::Vector<int> b(tinystl::move(a));
+    ASSERT_TRUE(a.empty());
+    ASSERT_EQ(a.capacity(), 0);
+    ASSERT_EQ(b.size(), 10);
+    ASSERT_EQ(b[9], 3);
+
+    tinystl::Vector<int> c(2, 1);
+    c = tinystl::move(b);
+    ASSERT_TRUE(b.empty());
+    ASSERT_EQ(c.size(), 10);
+    ASSERT_EQ(c[0], 3);
+}
+
+TEST(vector, moveElements) {
+    Movable::copies = 0;
+    Movable::moves = 0;
+    tinystl::Vector<Movable> a;
+    for(int i = 0; i < 100; ++i) {
+        a.pushBack(Movable(i));
+    }
+    // 扩容和插入都只移动元素
+    a.insert(a.begin(), Movable(-2));
+    a.erase(a.begin());
+    ASSERT_EQ(Movable::copies, 0);
+    for(int i = 0; i < 100; ++i) {
+        ASSERT_EQ(a[i].value, i);
+    }
+
+    Movable m(7);
+    a.pushBack(m);
+    ASSERT_EQ(Movable::copies, 1);
+    a.pushBack(tinystl::move(m));
+    ASSERT_EQ(Movable::copies, 1);
+    ASSERT_EQ(m.value, -1);
+    ASSERT_EQ(a.back().value, 7);
+}
+
+TEST(vector, emplace) {
+    Movable::copies = 0;
+    Movable::moves = 0;
+    tinystl::Vector<Movable> a;
+    a.reserve(4);
+    a.emplaceBack(1);
+    a.emplaceBack(3);
+    auto it = a.emplace(a.cbegin() + 1, 2);
+    ASSERT_EQ(it->value, 2);
+    ASSERT_EQ(Movable::copies, 0);
+    // 只有插入位置之后的元素被移动
+    ASSERT_EQ(Movable::moves, 2);
+    a.emplaceBack();
+    ASSERT_EQ(a.size(), 4);
+    ASSERT_EQ(a[0].value, 1);
+    ASSERT_EQ(a[1].value, 2);
+    ASSERT_EQ(a[2].value, 3);
+    ASSERT_EQ(a[3].value, 0);
+
+    tinystl::Vector<std::pair<int, std::string>> b;
+    for(int i = 0; i < 100; ++i) {
+        b.emplaceBack(i, std::string(i % 7, 'x'));
+    }
+    b.emplace(b.cbegin(), -1, "front");
+    ASSERT_EQ(b.size(), 101);
+    ASSERT_EQ(b[0].second, "front");
+    ASSERT_EQ(b[100].second, std::string(99 % 7, 'x'));
+
+    // 构造参数引用容器中的元素
+    tinystl::Vector<std::string> c(1, "abc");
+    while(c.size() < 100) {
+        c.emplaceBack(c[0], 1, 1);
+    }
+    ASSERT_EQ(c[99], "b");
+}
+
 int main(int argc, char *argv[])
 {
     ::testing::InitGoogleTest(&argc, argv);
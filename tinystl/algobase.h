@@ -12,9 +12,9 @@ namespace tinystl {
     // swap
     template<typename T>
     inline void swap(T &lhs, T &rhs) {
-        T temp = lhs;
-        lhs = rhs;
-        rhs = temp;
+        T temp = tinystl::move(lhs);
+        lhs = tinystl::move(rhs);
+        rhs = tinystl::move(temp);
     }
 
     // --------------------------------------------------------------------------------
@@ -47,6 +47,40 @@ namespace tinystl {
         return true;
     }
 
+    // [first2, first2 + distance(first1, last1))是否是[first1, last1)的一个排列
+    // 只要求元素能用==比较,复杂度为O(n^2)
+    template<typename ForwardIterator1, typename ForwardIterator2>
+    inline bool isPermutation(ForwardIterator1 first1, ForwardIterator1 last1,
+                              ForwardIterator2 first2) {
+        while(first1 != last1 && *first1 == *first2) {
+            ++first1;
+            ++first2;
+        }
+        ForwardIterator2 last2 = first2;
+        tinystl::advance(last2, tinystl::distance(first1, last1));
+        for(ForwardIterator1 it = first1; it != last1; ++it) {
+            // 每个值只在第一次出现时统计
+            ForwardIterator1 prev = first1;
+            while(prev != it && !(*prev == *it)) {
+                ++prev;
+            }
+            if(prev != it) {
+                continue;
+            }
+            std::size_t count1 = 0, count2 = 0;
+            for(ForwardIterator1 cur = it; cur != last1; ++cur) {
+                count1 += *cur == *it;
+            }
+            for(ForwardIterator2 cur = first2; cur != last2; ++cur) {
+                count2 += *cur == *it;
+            }
+            if(count1 != count2) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     template<typename InputIterator1, typename InputIterator2>
     inline bool less(InputIterator1 first1, InputIterator1 last1,
                      InputIterator2 first2) {
@@ -147,9 +181,30 @@ namespace tinystl {
         }
     };
 
+    // 比较任意两个能用<比较的对象,可以用于异构查找
+    template<>
+    struct Less<void> {
+        using IsTransparent = void;
+
+        template<typename T, typename U>
+        bool operator()(const T &lhs, const U &rhs) const {
+            return lhs < rhs;
+        }
+    };
+
+    template<>
+    struct Equal<void> {
+        using IsTransparent = void;
+
+        template<typename T, typename U>
+        bool operator()(const T &lhs, const U &rhs) const {
+            return lhs == rhs;
+        }
+    };
+
     template<typename T>
     struct Greater {
-        bool operator()(const T &lhs, const T &rhs) {
+        bool operator()(const T &lhs, const T &rhs) const {
             return lhs > rhs;
         }
     };
@@ -191,7 +246,10 @@ namespace tinystl {
 
     template<typename T>
     inline T* copyAux(const T *first, const T *last, T *result, TrueType) {
-        std::memmove(result, first, sizeof(T) * (last - first));
+        // 空区间的指针可能为nullptr,不能传给memmove
+        if(first != last) {
+            std::memmove(result, first, sizeof(T) * (last - first));
+        }
         return result + (last - first);
     }
 
@@ -230,7 +288,9 @@ namespace tinystl {
 
     template<typename T, typename Size>
     inline T* copyNAux(const T *first, Size count, T *result, TrueType) {
-        std::memmove(result, first, sizeof(T) * count);
+        if(count > 0) {
+            std::memmove(result, first, sizeof(T) * count);
+        }
         return result + count;
     }
 
@@ -289,19 +349,19 @@ namespace tinystl {
 
     template<typename Size>
     inline char* fillN(char *first, Size count, const char &value) {
-        fill(first, first + count, value);
+        tinystl::fill(first, first + count, value);
         return first + count;
     }
 
     template<typename Size>
     inline signed char* fillN(signed char *first, Size count, const signed char &value) {
-        fill(first, first + count, value);
+        tinystl::fill(first, first + count, value);
         return first + count;
     }
 
     template<typename Size>
     inline unsigned char* fillN(unsigned char *first, Size count, const unsigned char &value) {
-        fill(first, first + count, value);
+        tinystl::fill(first, first + count, value);
         return first + count;
     }
 
@@ -339,6 +399,29 @@ namespace tinystl {
         using IteratorCategory = typename IteratorTraits<BidirectionalIterator1>::IteratorCategory;
         return copyBackwardAux(first, last, result, IteratorCategory());
     }
+
+    // -----------------------------move---------------------------------------
+
+    template<typename InputIterator, typename OutputIterator>
+    inline OutputIterator move(InputIterator first, InputIterator last,
+                               OutputIterator result) {
+        while(first != last) {
+            *result = tinystl::move(*first);
+            ++result;
+            ++first;
+        }
+        return result;
+    }
+
+    template<typename BidirectionalIterator1, typename BidirectionalIterator2>
+    inline BidirectionalIterator2 moveBackward(BidirectionalIterator1 first,
+                                               BidirectionalIterator1 last,
+                                               BidirectionalIterator2 result) {
+        while(first != last) {
+            *--result = tinystl::move(*--last);
+        }
+        return result;
+    }
 }
 
 #endif
@@ -3,6 +3,14 @@
 #include <cstdlib>
 #include <cstring>
 #include <cassert>
+#include <cstdio>
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+#include "typetraits.h"
 
 #ifndef ALLOC_H
 #define ALLOC_H
@@ -78,84 +86,552 @@ namespace tinystl {
 
     using MallocAllocator = MallocAlloc<0>;
 
-    template<int inst>
+    // DefaultAlloc统计用的计数器
+    enum {
+        ALLOC_COUNTER_ALLOCATIONS,
+        ALLOC_COUNTER_HITS,
+        ALLOC_COUNTER_REFILLS,
+        ALLOC_COUNTER_CENTRAL_FETCHES,
+        ALLOC_COUNTER_CENTRAL_RELEASES,
+        ALLOC_COUNTER_DEALLOCATIONS,
+        ALLOC_COUNTER_CACHED_OBJECTS,
+        ALLOC_COUNTER_COUNT
+    };
+
+    // enabled为false时所有操作都是空操作,不占用线程缓存的空间
+    template<std::size_t N, bool enabled>
+    struct __AllocCounters {
+        void add(std::size_t, std::size_t, std::size_t = 1) {}
+        void set(std::size_t, std::size_t, std::size_t) {}
+        std::size_t get(std::size_t, std::size_t) const { return 0; }
+    };
+
+    template<std::size_t N>
+    struct __AllocCounters<N, true> {
+        // 每组计数器只有一个写者(所属线程或持有中心池锁的线程),
+        // 所以不需要原子的加法,其它线程只会读取
+        void add(std::size_t counter, std::size_t index, std::size_t n = 1) {
+            set(counter, index, get(counter, index) + n);
+        }
+        void set(std::size_t counter, std::size_t index, std::size_t value) {
+            values[counter][index].store(value, std::memory_order_relaxed);
+        }
+        std::size_t get(std::size_t counter, std::size_t index) const {
+            return values[counter][index].load(std::memory_order_relaxed);
+        }
+
+        std::atomic<std::size_t> values[ALLOC_COUNTER_COUNT][N];
+    };
+
+    inline std::size_t __floorLog2(std::size_t n) {
+#if defined(__GNUC__)
+        return sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(n);
+#else
+        std::size_t result = 0;
+        while(n >>= 1) {
+            ++result;
+        }
+        return result;
+#endif
+    }
+
+    // n不能为0
+    inline std::size_t __countTrailingZeros(std::size_t n) {
+#if defined(__GNUC__)
+        return __builtin_ctzll(n);
+#else
+        std::size_t result = 0;
+        while(!(n & 1)) {
+            n >>= 1;
+            ++result;
+        }
+        return result;
+#endif
+    }
+
+    constexpr std::size_t __constFloorLog2(std::size_t n) {
+        return n <= 1? 0: 1 + __constFloorLog2(n >> 1);
+    }
+
+    // DefaultAlloc的尺寸分级策略需要提供:
+    // ALIGN: 对象的对齐,也是所有分级的公约数, MAX_SIZE: 最大的分级, COUNT: 分级个数
+    // index(n): 能容纳n字节的最小分级, size(index): 分级的对象大小,
+    // batch(index): 每次refill或与中心池交换的对象个数
+
+    // 按align等距分级,与原先固定的8字节对齐、128字节上限的行为相同
+    template<std::size_t align, std::size_t maxSize, std::size_t refillCount>
+    struct LinearSizeClasses {
+        static_assert((align & (align - 1)) == 0 && align >= sizeof(void *),
+                      "align must be a power of 2 and can hold a pointer");
+        static_assert(maxSize % align == 0, "maxSize must be a multiple of align");
+
+        static const std::size_t ALIGN = align;
+        static const std::size_t MAX_SIZE = maxSize;
+        static const std::size_t COUNT = maxSize / align;
+
+        static std::size_t index(std::size_t n) {
+            return (n + ALIGN - 1) / ALIGN - 1;
+        }
+        static std::size_t size(std::size_t index) {
+            return (index + 1) * ALIGN;
+        }
+        static std::size_t batch(std::size_t) {
+            return refillCount;
+        }
+    };
+
+    template<std::size_t align, std::size_t maxSize, std::size_t refillCount>
+    const std::size_t LinearSizeClasses<align, maxSize, refillCount>::ALIGN;
+
+    template<std::size_t align, std::size_t maxSize, std::size_t refillCount>
+    const std::size_t LinearSizeClasses<align, maxSize, refillCount>::MAX_SIZE;
+
+    template<std::size_t align, std::size_t maxSize, std::size_t refillCount>
+    const std::size_t LinearSizeClasses<align, maxSize, refillCount>::COUNT;
+
+    // 前4级按align等距,之后每增大一倍分为4级,相邻分级的大小相差不超过25%,
+    // 分级个数随maxSize对数增长,可以覆盖到几KB的节点
+    // 每次refill大约取batchBytes字节,但个数限制在[2, 32]之间
+    template<std::size_t align, std::size_t maxSize, std::size_t batchBytes = 8192>
+    struct GeometricSizeClasses {
+        static_assert((align & (align - 1)) == 0 && align >= sizeof(void *),
+                      "align must be a power of 2 and can hold a pointer");
+        static_assert((maxSize & (maxSize - 1)) == 0 && maxSize >= align * 8,
+                      "maxSize must be a power of 2 and at least 8 * align");
+
+        static const std::size_t ALIGN = align;
+        static const std::size_t MAX_SIZE = maxSize;
+        static const std::size_t COUNT = 4 + (__constFloorLog2(maxSize / align) - 2) * 4;
+
+        static std::size_t index(std::size_t n) {
+            std::size_t units = (n + ALIGN - 1) / ALIGN;
+            if(units <= 4) {
+                return units - 1;
+            }
+            std::size_t log = __floorLog2(units - 1);
+            return 4 + (log - 2) * 4 + ((units - 1) >> (log - 2)) - 4;
+        }
+        static std::size_t size(std::size_t index) {
+            if(index < 4) {
+                return (index + 1) * ALIGN;
+            }
+            std::size_t shift = (index - 4) / 4;
+            return ((index - 4) % 4 + 5) * ALIGN << shift;
+        }
+        static std::size_t batch(std::size_t index) {
+            std::size_t count = batchBytes / size(index);
+            return count < 2? 2: (count > 32? 32: count);
+        }
+    };
+
+    template<std::size_t align, std::size_t maxSize, std::size_t batchBytes>
+    const std::size_t GeometricSizeClasses<align, maxSize, batchBytes>::ALIGN;
+
+    template<std::size_t align, std::size_t maxSize, std::size_t batchBytes>
+    const std::size_t GeometricSizeClasses<align, maxSize, batchBytes>::MAX_SIZE;
+
+    template<std::size_t align, std::size_t maxSize, std::size_t batchBytes>
+    const std::size_t GeometricSizeClasses<align, maxSize, batchBytes>::COUNT;
+
+    // DefaultAlloc的chunk来源需要提供:
+    // allocate(size, align): 申请至少size字节、按align对齐的内存,可以把size调大,失败时返回nullptr
+    // deallocate(ptr, size): 归还allocate得到的内存,size为allocate调整后的大小
+
+    // 直接使用malloc,对齐要求超过malloc的保证时使用posix_memalign
+    struct MallocChunkSource {
+        static void* allocate(std::size_t &size, std::size_t align) {
+            if(align <= alignof(std::max_align_t)) {
+                return std::malloc(size);
+            }
+            void *result = nullptr;
+            return posix_memalign(&result, align, size) == 0? result: nullptr;
+        }
+
+        static void deallocate(void *ptr, std::size_t) {
+            std::free(ptr);
+        }
+    };
+
+    // 用mmap申请按regionSize对齐的大块内存,并通过MADV_HUGEPAGE让内核使用透明大页,
+    // 减少在大量节点间跳转时的TLB miss。内核不支持时仍然是普通页,
+    // 不支持mmap的平台上退化为MallocChunkSource
+    template<std::size_t regionSize = 2 * 1024 * 1024>
+    struct HugePageChunkSource {
+        static_assert((regionSize & (regionSize - 1)) == 0, "regionSize must be a power of 2");
+
+        static void* allocate(std::size_t &size, std::size_t align) {
+#if defined(__linux__)
+            size = (size + regionSize - 1) & ~(regionSize - 1);
+            // 按regionSize和align中较大的一个对齐,align需要是2的幂
+            const std::size_t alignment = align > regionSize? align: regionSize;
+            // 多映射一个alignment用于对齐,再把首尾多余的部分解除映射
+            std::size_t mapSize = size + alignment;
+            void *ptr = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if(ptr == MAP_FAILED) {
+                return nullptr;
+            }
+            char *mapStart = static_cast<char *>(ptr);
+            char *mapEnd = mapStart + mapSize;
+            char *start = reinterpret_cast<char *>(
+                (reinterpret_cast<std::uintptr_t>(mapStart) + alignment - 1) & ~(alignment - 1));
+            if(start != mapStart) {
+                munmap(mapStart, start - mapStart);
+            }
+            if(start + size != mapEnd) {
+                munmap(start + size, mapEnd - start - size);
+            }
+#ifdef MADV_HUGEPAGE
+            madvise(start, size, MADV_HUGEPAGE);
+#endif
+            return start;
+#else
+            return MallocChunkSource::allocate(size, align);
+#endif
+        }
+
+        static void deallocate(void *ptr, std::size_t size) {
+#if defined(__linux__)
+            munmap(ptr, size);
+#else
+            MallocChunkSource::deallocate(ptr, size);
+#endif
+        }
+    };
+
+    // threads为true时,每个线程拥有自己的freeList和chunk游标(线程缓存),
+    // 线程缓存为空时从中心池批量取回对象,线程缓存过多时批量归还给中心池,
+    // 只有在和中心池交换对象或申请新chunk时才需要加锁
+    // statistics为true时记录每个线程的分配统计,在getStats时合并
+    // SizeClasses决定小对象的分级,超过SizeClasses::MAX_SIZE的分配交给MallocAllocator
+    // ChunkSource决定chunk从哪里申请,例如HugePageChunkSource
+    template<int inst, bool threads = false, bool statistics = false,
+             typename SizeClasses = LinearSizeClasses<8, 128, 20>,
+             typename ChunkSource = MallocChunkSource>
     class DefaultAlloc {
+    private:
+        const static std::size_t ALIGN = SizeClasses::ALIGN;
+        const static std::size_t MAX_SIZE = SizeClasses::MAX_SIZE;
+        const static std::size_t FREE_LIST_COUNT = SizeClasses::COUNT;
+
     public:
+        // 统计信息的快照
+        struct Stats {
+            struct SizeClass {
+                std::size_t objectSize;
+                std::size_t allocations;
+                // 直接从线程缓存的freeList上取到对象的次数
+                std::size_t hits;
+                std::size_t refills;
+                std::size_t centralFetches;
+                std::size_t centralReleases;
+                std::size_t deallocations;
+                // 线程缓存和中心池的freeList上空闲的对象个数
+                std::size_t cachedObjects;
+                std::size_t centralObjects;
+
+                double hitRate() const {
+                    return allocations? static_cast<double>(hits) / allocations: 0.0;
+                }
+                std::size_t freeBytes() const {
+                    return (cachedObjects + centralObjects) * objectSize;
+                }
+            };
+
+            std::size_t freeListBytes() const {
+                std::size_t bytes = 0;
+                for(std::size_t i = 0; i < FREE_LIST_COUNT; ++i) {
+                    bytes += sizeClasses[i].freeBytes();
+                }
+                return bytes;
+            }
+
+            SizeClass sizeClasses[FREE_LIST_COUNT];
+            // 超过MAX_SIZE直接交给MallocAllocator的分配
+            std::size_t largeAllocations;
+            std::size_t largeDeallocations;
+            std::size_t chunkCount;
+            std::size_t chunkBytes;
+            // allocChunk中malloc失败,最终交给MallocAllocator的次数
+            std::size_t mallocFallbacks;
+            std::size_t threadCount;
+        };
+
         static void* allocate(std::size_t n) {
             if(n == 0) {
                 return nullptr;
             }
+            Cache &cache = localCache();
             if(n > MAX_SIZE) {
+                countLarge(cache, ALLOC_COUNTER_ALLOCATIONS);
                 return MallocAllocator::allocate(n);
             }
             std::size_t index = freeListIndex(n);
-            if(freeLists[index]) {
-                void* result = freeLists[index];
-                freeLists[index] = freeLists[index]->next;
+            if(threads && cache.detached) {
+                // 线程缓存已经在线程退出时归还,之后的分配直接从中心池取,不再缓存
+                return allocateFromCentral(index);
+            }
+            cache.counters.add(ALLOC_COUNTER_ALLOCATIONS, index);
+            Obj *result = cache.freeLists[index];
+            if(result) {
+                cache.freeLists[index] = result->next;
+                --cache.listLengths[index];
+                cache.counters.add(ALLOC_COUNTER_HITS, index);
+                updateCachedCount(cache, index);
                 return result;
             }
-            return refill(roundUp(n));
+            cache.counters.add(ALLOC_COUNTER_REFILLS, index);
+            return refill(cache, classSize(index));
         }
 
         static void deallocate(void *ptr, std::size_t n) {
+            if(!ptr) {
+                return;
+            }
+            Cache &cache = localCache();
             if(n > MAX_SIZE) {
+                countLarge(cache, ALLOC_COUNTER_DEALLOCATIONS);
                 return MallocAllocator::deallocate(ptr, n);
             }
             std::size_t index = freeListIndex(n);
             Obj *obj = static_cast<Obj *>(ptr);
-            obj->next = freeLists[index];
-            freeLists[index] = obj;
+            if(threads && !cache.attached) {
+                attachCache(cache);
+            }
+            if(threads && cache.detached) {
+                // 线程缓存已经在线程退出时归还,之后释放的对象直接交给中心池
+                CentralLock lock;
+                retiredCounters.add(ALLOC_COUNTER_DEALLOCATIONS, index);
+                pushList(centralFreeLists[index], centralListLengths[index], obj, obj, 1);
+                return;
+            }
+            cache.counters.add(ALLOC_COUNTER_DEALLOCATIONS, index);
+            obj->next = cache.freeLists[index];
+            cache.freeLists[index] = obj;
+            // 非线程模式下只有开启了自动trim才需要把多余的对象交给中心池
+            if(++cache.listLengths[index] > maxCachedCount(index) && (threads || autoTrimThreshold)) {
+                releaseToCentral(cache, index, cache.listLengths[index] / 2);
+            }
+            updateCachedCount(cache, index);
         }
 
         static void* reallocate(void *ptr, std::size_t oldSize, std::size_t newSize);
 
+        // 合并所有线程的计数,statistics为false时只有chunk相关的信息
+        static Stats getStats();
+        static void dumpStats(std::FILE *out = stderr);
+
+        // 将当前线程缓存归还给中心池,然后把所有对象都在freeList上的chunk还给系统,
+        // 返回还给系统的字节数。其它线程缓存中的对象所在的chunk不会被释放
+        static std::size_t trim();
+        // 中心池的空闲字节比上次trim后多出threshold时自动trim,0表示关闭
+        // 缓存中的freeList超过上限时多余的对象会交给中心池,然后检查是否需要trim
+        static void setAutoTrimThreshold(std::size_t threshold);
+
     private:
         union Obj {
             Obj *next;
             char data[0];
         };
 
+        using Counters = __AllocCounters<FREE_LIST_COUNT + 1, statistics>;
+
+        struct Chunk {
+            char *start;
+            std::size_t size;
+            // 由MallocAllocator兜底分配,而不是来自ChunkSource
+            bool fromMalloc;
+        };
+
+        // 线程缓存,非线程模式下只有一个全局的缓存
+        struct Cache {
+            Obj *freeLists[FREE_LIST_COUNT];
+            std::size_t listLengths[FREE_LIST_COUNT];
+            char *freeStartPtr;
+            char *freeEndPtr;
+            // 是否已注册线程退出时的归还
+            bool attached;
+            // 线程退出,缓存已归还给中心池
+            bool detached;
+            // 已注册的线程缓存组成的链表,用于合并统计信息
+            Cache *prevCache;
+            Cache *nextCache;
+            // 最后一个位置记录超过MAX_SIZE的分配
+            Counters counters;
+        };
+
+        // 线程退出时将线程缓存中的对象归还给中心池
+        struct CacheReleaser {
+            ~CacheReleaser() {
+                releaseCache(threadCache);
+                detachCache(threadCache);
+            }
+        };
+
+        struct CentralLock {
+            CentralLock() {
+                if(threads) {
+                    centralMutex.lock();
+                }
+            }
+            ~CentralLock() {
+                if(threads) {
+                    centralMutex.unlock();
+                }
+            }
+        };
+
         static std::size_t roundUp(std::size_t n) {
             return (n + ALIGN - 1) & (~(ALIGN - 1));
         }
 
         static std::size_t freeListIndex(std::size_t n) {
-            return (n + ALIGN - 1) / ALIGN - 1;
+            return SizeClasses::index(n);
+        }
+
+        static std::size_t classSize(std::size_t index) {
+            return SizeClasses::size(index);
+        }
+
+        // 每次refill或者与中心池交换的对象个数
+        static std::size_t refillCount(std::size_t index) {
+            return SizeClasses::batch(index);
+        }
+
+        // 线程缓存中每个freeList最多保留的对象个数
+        static std::size_t maxCachedCount(std::size_t index) {
+            return refillCount(index) * 8;
+        }
+
+        static Cache& localCache() {
+            return threads? threadCache: globalCache;
+        }
+
+        static void updateCachedCount(Cache &cache, std::size_t index) {
+            cache.counters.set(ALLOC_COUNTER_CACHED_OBJECTS, index, cache.listLengths[index]);
+        }
+
+        // 超过MAX_SIZE的分配不经过线程缓存,但计数仍然要能被getStats合并到
+        static void countLarge(Cache &cache, std::size_t counter) {
+            if(!statistics) {
+                return;
+            }
+            if(threads && !cache.attached) {
+                attachCache(cache);
+            }
+            if(threads && cache.detached) {
+                CentralLock lock;
+                retiredCounters.add(counter, FREE_LIST_COUNT);
+                return;
+            }
+            cache.counters.add(counter, FREE_LIST_COUNT);
+        }
+
+        static void pushList(Obj* &list, std::size_t &length,
+                             Obj *first, Obj *last, std::size_t count) {
+            last->next = list;
+            list = first;
+            length += count;
         }
 
+        static void attachCache(Cache &cache);
+        static void detachCache(Cache &cache);
         // 返回分配的空间,并将剩余的添加到n相应的freelist中
-        static void* refill(std::size_t n);
+        static void* refill(Cache &cache, std::size_t n);
+        // 不经过线程缓存从中心池分配一个对象,中心池为空时申请新chunk切分到中心池
+        static void* allocateFromCentral(std::size_t index);
         // 返回分配的n * nObj大小的空间指针,如果空间不够分配nObj个,则可能减少nObj
-        static char* allocChunk(std::size_t n, std::size_t &nObj);
+        static char* allocChunk(Cache &cache, std::size_t n, std::size_t &nObj);
+        // 向系统申请一个新的chunk
+        static char* newChunk(std::size_t &byteSize);
+        // 以下几个函数需要在持有中心池锁的情况下调用
+        // 按地址顺序记录chunk,以便trim时找到对象所属的chunk
+        static void registerChunk(char *start, std::size_t size, bool fromMalloc = false);
+        static std::size_t findChunk(const char *ptr);
+        static std::size_t centralFreeBytes();
+        static std::size_t trimCentral();
+        // 将[start, start + size)切分成对象挂到freeLists上
+        static void carve(Obj **lists, std::size_t *lengths, char *start, std::size_t size);
+        // 从中心池批量取回对象到线程缓存,返回取回的个数
+        static std::size_t fetchFromCentral(Cache &cache, std::size_t index);
+        // 将线程缓存index对应的freeList的前count个对象归还给中心池
+        static void releaseToCentral(Cache &cache, std::size_t index, std::size_t count);
+        // 将整个线程缓存归还给中心池
+        static void releaseCache(Cache &cache);
 
-        const static std::size_t ALIGN = 8;
-        const static std::size_t MAX_SIZE = 128;
-        const static std::size_t FREE_LIST_COUNT = MAX_SIZE / ALIGN;
+        static Cache globalCache;
+        static thread_local Cache threadCache;
 
-        static Obj* freeLists[FREE_LIST_COUNT];
-        static char* freeStartPtr;
-        static char* freeEndPtr;
+        static Obj* centralFreeLists[FREE_LIST_COUNT];
+        static std::size_t centralListLengths[FREE_LIST_COUNT];
+        static std::mutex centralMutex;
         static std::size_t totalSize;
+        static std::size_t chunkCount;
+        static std::size_t mallocFallbacks;
+        static Cache *cacheList;
+        // 已退出线程的统计
+        static Counters retiredCounters;
+        static Chunk *chunks;
+        static std::size_t chunkCapacity;
+        static std::size_t autoTrimThreshold;
+        static std::size_t autoTrimMark;
     };
 
-    template<int inst>
-    typename DefaultAlloc<inst>::Obj* DefaultAlloc<inst>::freeLists[DefaultAlloc<inst>::FREE_LIST_COUNT] = {0};
+    template<int inst, bool threads, bool statistics, typename SizeClasses, typename ChunkSource>
+    typename DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::Cache
+    DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::globalCache;
 
-    template<int inst>
-    char* DefaultAlloc<inst>::freeStartPtr = nullptr;
+    template<int inst, bool threads, bool statistics, typename SizeClasses, typename ChunkSource>
+    thread_local typename DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::Cache
+    DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::threadCache;
 
-    template<int inst>
-    char* DefaultAlloc<inst>::freeEndPtr = nullptr;
+    template<int inst, bool threads, bool statistics, typename SizeClasses, typename ChunkSource>
+    typename DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::Obj*
+    DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::centralFreeLists[FREE_LIST_COUNT] = {0};
 
-    template<int inst>
-    std::size_t DefaultAlloc<inst>::totalSize = 0;
+    template<int inst, bool threads, bool statistics, typename SizeClasses, typename ChunkSource>
+    std::size_t DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::centralListLengths[FREE_LIST_COUNT] = {0};
 
-    template<int inst>
-    void* DefaultAlloc<inst>::reallocate( void *ptr, std::size_t oldSize, std::size_t newSize) {
+    template<int inst, bool threads, bool statistics, typename SizeClasses, typename ChunkSource>
+    std::mutex DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::centralMutex;
+
+    template<int inst, bool threads, bool statistics, typename SizeClasses, typename ChunkSource>
+    std::size_t DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::totalSize = 0;
+
+    template<int inst, bool threads, bool statistics, typename SizeClasses, typename ChunkSource>
+    std::size_t DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::chunkCount = 0;
+
+    template<int inst, bool threads, bool statistics, typename SizeClasses, typename ChunkSource>
+    std::size_t DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::mallocFallbacks = 0;
+
+    template<int inst, bool threads, bool statistics, typename SizeClasses, typename ChunkSource>
+    typename DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::Cache*
+    DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::cacheList = nullptr;
+
+    template<int inst, bool threads, bool statistics, typename SizeClasses, typename ChunkSource>
+    typename DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::Counters
+    DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::retiredCounters;
+
+    template<int inst, bool threads, bool statistics, typename SizeClasses, typename ChunkSource>
+    typename DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::Chunk*
+    DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::chunks = nullptr;
+
+    template<int inst, bool threads, bool statistics, typename SizeClasses, typename ChunkSource>
+    std::size_t DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::chunkCapacity = 0;
+
+    template<int inst, bool threads, bool statistics, typename SizeClasses, typename ChunkSource>
+    std::size_t DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::autoTrimThreshold = 0;
+
+    template<int inst, bool threads, bool statistics, typename SizeClasses, typename ChunkSource>
+    std::size_t DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::autoTrimMark = 0;
+
+    template<int inst, bool threads, bool statistics, typename SizeClasses, typename ChunkSource>
+    void* DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::reallocate( void *ptr, std::size_t oldSize, std::size_t newSize) {
         if(oldSize > MAX_SIZE && newSize > MAX_SIZE) {
             return MallocAllocator::reallocate(ptr, oldSize, newSize);
         }
-        if(roundUp(oldSize) == roundUp(newSize)) {
+        if(oldSize <= MAX_SIZE && newSize <= MAX_SIZE
+           && freeListIndex(oldSize) == freeListIndex(newSize)) {
             return ptr;
         }
         void *result = allocate(newSize);
@@ -165,79 +641,468 @@ namespace tinystl {
         return result;
     }
 
-    template<int inst>
-    char* DefaultAlloc<inst>::allocChunk(std::size_t n, std::size_t &nObj) {
+    template<int inst, bool threads, bool statistics, typename SizeClasses, typename ChunkSource>
+    void DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::attachCache(Cache &cache) {
+        static thread_local CacheReleaser releaser;
+        (void)releaser;
+        cache.attached = true;
+        CentralLock lock;
+        cache.prevCache = nullptr;
+        cache.nextCache = cacheList;
+        if(cacheList) {
+            cacheList->prevCache = &cache;
+        }
+        cacheList = &cache;
+    }
+
+    template<int inst, bool threads, bool statistics, typename SizeClasses, typename ChunkSource>
+    void DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::detachCache(Cache &cache) {
+        CentralLock lock;
+        for(std::size_t counter = 0; counter < ALLOC_COUNTER_COUNT; ++counter) {
+            if(counter == ALLOC_COUNTER_CACHED_OBJECTS) {
+                continue;
+            }
+            for(std::size_t i = 0; i <= FREE_LIST_COUNT; ++i) {
+                retiredCounters.add(counter, i, cache.counters.get(counter, i));
+            }
+        }
+        if(cache.prevCache) {
+            cache.prevCache->nextCache = cache.nextCache;
+        } else {
+            cacheList = cache.nextCache;
+        }
+        if(cache.nextCache) {
+            cache.nextCache->prevCache = cache.prevCache;
+        }
+        cache.detached = true;
+    }
+
+    template<int inst, bool threads, bool statistics, typename SizeClasses, typename ChunkSource>
+    char* DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::newChunk(std::size_t &byteSize) {
+        CentralLock lock;
+        byteSize += roundUp(totalSize >> 4);
+        char *result = static_cast<char *>(ChunkSource::allocate(byteSize, ALIGN));
+        if(result) {
+            registerChunk(result, byteSize);
+        }
+        return result;
+    }
+
+    template<int inst, bool threads, bool statistics, typename SizeClasses, typename ChunkSource>
+    void DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::registerChunk(char *start, std::size_t size,
+                                                                                          bool fromMalloc) {
+        totalSize += size;
+        if(chunkCount == chunkCapacity) {
+            std::size_t newCapacity = chunkCapacity? chunkCapacity * 2: 16;
+            Chunk *newChunks = static_cast<Chunk *>(std::realloc(chunks, newCapacity * sizeof(Chunk)));
+            if(!newChunks) {
+                // 没有记录的chunk不会被trim,但仍然可以正常使用
+                return;
+            }
+            chunks = newChunks;
+            chunkCapacity = newCapacity;
+        }
+        std::size_t pos = chunkCount;
+        while(pos > 0 && chunks[pos - 1].start > start) {
+            chunks[pos] = chunks[pos - 1];
+            --pos;
+        }
+        chunks[pos].start = start;
+        chunks[pos].size = size;
+        chunks[pos].fromMalloc = fromMalloc;
+        ++chunkCount;
+    }
+
+    template<int inst, bool threads, bool statistics, typename SizeClasses, typename ChunkSource>
+    std::size_t DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::findChunk(const char *ptr) {
+        // 返回包含ptr的chunk的下标,不存在时返回chunkCount
+        std::size_t first = 0;
+        std::size_t last = chunkCount;
+        while(first < last) {
+            std::size_t mid = first + (last - first) / 2;
+            if(chunks[mid].start <= ptr) {
+                first = mid + 1;
+            } else {
+                last = mid;
+            }
+        }
+        if(first == 0 || ptr >= chunks[first - 1].start + chunks[first - 1].size) {
+            return chunkCount;
+        }
+        return first - 1;
+    }
+
+    template<int inst, bool threads, bool statistics, typename SizeClasses, typename ChunkSource>
+    std::size_t DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::centralFreeBytes() {
+        std::size_t bytes = 0;
+        for(std::size_t i = 0; i < FREE_LIST_COUNT; ++i) {
+            bytes += centralListLengths[i] * classSize(i);
+        }
+        return bytes;
+    }
+
+    template<int inst, bool threads, bool statistics, typename SizeClasses, typename ChunkSource>
+    std::size_t DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::trimCentral() {
+        if(chunkCount == 0) {
+            return 0;
+        }
+        std::size_t *freeBytes = static_cast<std::size_t *>(std::calloc(chunkCount, sizeof(std::size_t)));
+        if(!freeBytes) {
+            return 0;
+        }
+        // 统计每个chunk中在中心池freeList上的字节数
+        for(std::size_t i = 0; i < FREE_LIST_COUNT; ++i) {
+            for(Obj *obj = centralFreeLists[i]; obj; obj = obj->next) {
+                std::size_t chunkNo = findChunk(reinterpret_cast<char *>(obj));
+                if(chunkNo != chunkCount) {
+                    freeBytes[chunkNo] += classSize(i);
+                }
+            }
+        }
+        bool hasIdleChunk = false;
+        for(std::size_t i = 0; i < chunkCount; ++i) {
+            if(freeBytes[i] == chunks[i].size) {
+                hasIdleChunk = true;
+                break;
+            }
+        }
+        if(!hasIdleChunk) {
+            std::free(freeBytes);
+            return 0;
+        }
+        // 把属于空闲chunk的对象从freeList上摘掉
+        for(std::size_t i = 0; i < FREE_LIST_COUNT; ++i) {
+            Obj **link = &centralFreeLists[i];
+            while(*link) {
+                std::size_t chunkNo = findChunk(reinterpret_cast<char *>(*link));
+                if(chunkNo != chunkCount && freeBytes[chunkNo] == chunks[chunkNo].size) {
+                    *link = (*link)->next;
+                    --centralListLengths[i];
+                } else {
+                    link = &(*link)->next;
+                }
+            }
+        }
+        std::size_t releasedBytes = 0;
+        std::size_t keptCount = 0;
+        for(std::size_t i = 0; i < chunkCount; ++i) {
+            if(freeBytes[i] == chunks[i].size) {
+                releasedBytes += chunks[i].size;
+                if(chunks[i].fromMalloc) {
+                    MallocAllocator::deallocate(chunks[i].start, chunks[i].size);
+                } else {
+                    ChunkSource::deallocate(chunks[i].start, chunks[i].size);
+                }
+            } else {
+                chunks[keptCount++] = chunks[i];
+            }
+        }
+        std::free(freeBytes);
+        chunkCount = keptCount;
+        totalSize -= releasedBytes;
+        return releasedBytes;
+    }
+
+    template<int inst, bool threads, bool statistics, typename SizeClasses, typename ChunkSource>
+    std::size_t DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::trim() {
+        Cache &cache = localCache();
+        if(!cache.detached) {
+            releaseCache(cache);
+        }
+        CentralLock lock;
+        std::size_t releasedBytes = trimCentral();
+        autoTrimMark = centralFreeBytes();
+        return releasedBytes;
+    }
+
+    template<int inst, bool threads, bool statistics, typename SizeClasses, typename ChunkSource>
+    void DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::setAutoTrimThreshold(std::size_t threshold) {
+        CentralLock lock;
+        autoTrimThreshold = threshold;
+        autoTrimMark = centralFreeBytes();
+    }
+
+    template<int inst, bool threads, bool statistics, typename SizeClasses, typename ChunkSource>
+    void DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::carve(Obj **lists, std::size_t *lengths,
+                                                                                  char *start, std::size_t size) {
+        while(size) {
+            // 取不超过size的最大分级
+            std::size_t index = freeListIndex(size < MAX_SIZE? size: MAX_SIZE);
+            if(classSize(index) > size) {
+                --index;
+            }
+            std::size_t objSize = classSize(index);
+            Obj *obj = reinterpret_cast<Obj *>(start);
+            pushList(lists[index], lengths[index], obj, obj, 1);
+            start += objSize;
+            size -= objSize;
+        }
+    }
+
+    template<int inst, bool threads, bool statistics, typename SizeClasses, typename ChunkSource>
+    char* DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::allocChunk(Cache &cache, std::size_t n,
+                                                                                        std::size_t &nObj) {
         std::size_t totalWantedSize = n * nObj;
-        std::size_t leftSize = freeEndPtr - freeStartPtr;
+        std::size_t leftSize = cache.freeEndPtr - cache.freeStartPtr;
         if(leftSize >= totalWantedSize) {
-            char *result = freeStartPtr;
-            freeStartPtr += totalWantedSize;
+            char *result = cache.freeStartPtr;
+            cache.freeStartPtr += totalWantedSize;
             return result;
         }
 
         if(leftSize >= n) {
             nObj = leftSize / n;
-            char *result = freeStartPtr;
-            freeStartPtr += n * nObj;
+            char *result = cache.freeStartPtr;
+            cache.freeStartPtr += n * nObj;
             return result;
         }
 
-        // 把还残存但不够分配的空间添加到合适的freeList中
+        // 把还残存但不够分配的空间添加到中心池合适的freeList中,
+        // 留在线程缓存里会使这个chunk一直不能被自动trim
         if(leftSize) {
-            std::size_t index = freeListIndex(leftSize);
-            Obj *obj = reinterpret_cast<Obj*>(freeStartPtr);
-            obj->next = freeLists[index];
-            freeLists[index] = obj;
-            freeStartPtr += leftSize;
-        }
-        std::size_t byteSizeToGet = totalWantedSize * 2 + roundUp(totalSize >> 4);
-        void *newBuf = std::malloc(byteSizeToGet);
+            CentralLock lock;
+            carve(centralFreeLists, centralListLengths, cache.freeStartPtr, leftSize);
+            cache.freeStartPtr += leftSize;
+        }
+        std::size_t byteSizeToGet = totalWantedSize * 2;
+        char *newBuf = newChunk(byteSizeToGet);
         if(newBuf) {
-            char *result = static_cast<char*>(newBuf);
-            freeStartPtr = result + totalWantedSize;
-            freeEndPtr = result + byteSizeToGet;
-            totalSize += byteSizeToGet;
-            return result;
+            cache.freeStartPtr = newBuf + totalWantedSize;
+            cache.freeEndPtr = newBuf + byteSizeToGet;
+            return newBuf;
         }
         // 如果重新malloc申请失败,则从比n大的freeList中尝试窃取
         for(std::size_t i = freeListIndex(n); i < FREE_LIST_COUNT; ++i) {
-            if(!freeLists[i]) {
+            if(!cache.freeLists[i] && (!threads || !fetchFromCentral(cache, i))) {
                 continue;
             }
-            freeStartPtr = reinterpret_cast<char *>(freeLists[i]);
-            freeEndPtr = freeStartPtr + (i + 1) * 8;
-            freeLists[i] = freeLists[i]->next;
-            return allocChunk(n, nObj);
+            cache.freeStartPtr = reinterpret_cast<char *>(cache.freeLists[i]);
+            cache.freeEndPtr = cache.freeStartPtr + classSize(i);
+            cache.freeLists[i] = cache.freeLists[i]->next;
+            --cache.listLengths[i];
+            updateCachedCount(cache, i);
+            return allocChunk(cache, n, nObj);
         }
-        // 如果比它大的也没有空间,则让MallocAllocator去处理
-        freeStartPtr = static_cast<char*>(MallocAllocator::allocate(byteSizeToGet));
-        freeEndPtr = freeStartPtr + byteSizeToGet;
-        totalWantedSize += byteSizeToGet;
-        return allocChunk(n, nObj);
+        // 如果比它大的也没有空间,则让MallocAllocator去处理,它不能保证更大的对齐
+        if(ALIGN > alignof(std::max_align_t)) {
+            throw std::bad_alloc();
+        }
+        cache.freeStartPtr = static_cast<char*>(MallocAllocator::allocate(byteSizeToGet));
+        cache.freeEndPtr = cache.freeStartPtr + byteSizeToGet;
+        {
+            CentralLock lock;
+            registerChunk(cache.freeStartPtr, byteSizeToGet, true);
+            ++mallocFallbacks;
+        }
+        return allocChunk(cache, n, nObj);
     }
 
-    template<int inst>
-    void* DefaultAlloc<inst>::refill(std::size_t n) {
-        std::size_t nObj = 20;
-        char *result = allocChunk(n, nObj);
+    template<int inst, bool threads, bool statistics, typename SizeClasses, typename ChunkSource>
+    void* DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::refill(Cache &cache, std::size_t n) {
+        std::size_t index = freeListIndex(n);
+        if(threads && !cache.attached) {
+            attachCache(cache);
+        }
+        // 非线程模式下中心池中只有chunk残存的部分和trim或自动trim时归还的对象
+        if(fetchFromCentral(cache, index)) {
+            Obj *result = cache.freeLists[index];
+            cache.freeLists[index] = result->next;
+            --cache.listLengths[index];
+            updateCachedCount(cache, index);
+            return result;
+        }
+
+        std::size_t nObj = refillCount(index);
+        char *result = allocChunk(cache, n, nObj);
         if(1 == nObj) {
             return result;
         }
 
-        for(int i = 1; i < nObj - 1; ++i) {
+        for(std::size_t i = 1; i < nObj - 1; ++i) {
             Obj *obj = reinterpret_cast<Obj *>(result + n * i);
             Obj *nextObj = reinterpret_cast<Obj *>(result + n * i + n);
             obj->next = nextObj;
         }
-        Obj *obj = reinterpret_cast<Obj *>(result + n * (nObj - 1));
-        obj->next = nullptr;
+        Obj *first = reinterpret_cast<Obj *>(result + n);
+        Obj *last = reinterpret_cast<Obj *>(result + n * (nObj - 1));
+        pushList(cache.freeLists[index], cache.listLengths[index], first, last, nObj - 1);
+        updateCachedCount(cache, index);
+        return result;
+    }
 
-        std::size_t index = freeListIndex(n);
-        freeLists[index] = reinterpret_cast<Obj *>(result + n);
+    template<int inst, bool threads, bool statistics, typename SizeClasses, typename ChunkSource>
+    void* DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::allocateFromCentral(std::size_t index) {
+        const std::size_t n = classSize(index);
+        {
+            CentralLock lock;
+            retiredCounters.add(ALLOC_COUNTER_ALLOCATIONS, index);
+            Obj *result = centralFreeLists[index];
+            if(result) {
+                centralFreeLists[index] = result->next;
+                --centralListLengths[index];
+                return result;
+            }
+        }
+        std::size_t byteSize = n * refillCount(index);
+        char *chunk = newChunk(byteSize);
+        CentralLock lock;
+        if(!chunk) {
+            if(ALIGN > alignof(std::max_align_t)) {
+                throw std::bad_alloc();
+            }
+            chunk = static_cast<char *>(MallocAllocator::allocate(byteSize));
+            registerChunk(chunk, byteSize, true);
+            ++mallocFallbacks;
+        }
+        // 第一个对象返回,其余的和不够一个对象的尾部都挂到中心池
+        std::size_t nObj = byteSize / n;
+        for(std::size_t i = 1; i < nObj; ++i) {
+            Obj *obj = reinterpret_cast<Obj *>(chunk + n * i);
+            pushList(centralFreeLists[index], centralListLengths[index], obj, obj, 1);
+        }
+        if(byteSize > n * nObj) {
+            carve(centralFreeLists, centralListLengths, chunk + n * nObj, byteSize - n * nObj);
+        }
+        return chunk;
+    }
+
+    template<int inst, bool threads, bool statistics, typename SizeClasses, typename ChunkSource>
+    std::size_t DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::fetchFromCentral(Cache &cache,
+                                                                                                    std::size_t index) {
+        Obj *first = nullptr;
+        Obj *last = nullptr;
+        std::size_t count = 0;
+        {
+            CentralLock lock;
+            first = centralFreeLists[index];
+            if(!first) {
+                return 0;
+            }
+            last = first;
+            count = 1;
+            while(count < refillCount(index) && last->next) {
+                last = last->next;
+                ++count;
+            }
+            centralFreeLists[index] = last->next;
+            centralListLengths[index] -= count;
+        }
+        pushList(cache.freeLists[index], cache.listLengths[index], first, last, count);
+        cache.counters.add(ALLOC_COUNTER_CENTRAL_FETCHES, index);
+        updateCachedCount(cache, index);
+        return count;
+    }
+
+    template<int inst, bool threads, bool statistics, typename SizeClasses, typename ChunkSource>
+    void DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::releaseToCentral(Cache &cache, std::size_t index,
+                                                                                             std::size_t count) {
+        if(count == 0) {
+            return;
+        }
+        Obj *first = cache.freeLists[index];
+        Obj *last = first;
+        for(std::size_t i = 1; i < count; ++i) {
+            last = last->next;
+        }
+        cache.freeLists[index] = last->next;
+        cache.listLengths[index] -= count;
+        cache.counters.add(ALLOC_COUNTER_CENTRAL_RELEASES, index);
+        updateCachedCount(cache, index);
+        CentralLock lock;
+        pushList(centralFreeLists[index], centralListLengths[index], first, last, count);
+        if(autoTrimThreshold) {
+            std::size_t freeBytes = centralFreeBytes();
+            if(freeBytes > autoTrimMark + autoTrimThreshold) {
+                trimCentral();
+                autoTrimMark = centralFreeBytes();
+            } else if(freeBytes < autoTrimMark) {
+                autoTrimMark = freeBytes;
+            }
+        }
+    }
+
+    template<int inst, bool threads, bool statistics, typename SizeClasses, typename ChunkSource>
+    void DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::releaseCache(Cache &cache) {
+        for(std::size_t i = 0; i < FREE_LIST_COUNT; ++i) {
+            releaseToCentral(cache, i, cache.listLengths[i]);
+        }
+        // chunk中还没有切分的部分也一并归还
+        std::size_t leftSize = cache.freeEndPtr - cache.freeStartPtr;
+        if(leftSize) {
+            CentralLock lock;
+            carve(centralFreeLists, centralListLengths, cache.freeStartPtr, leftSize);
+        }
+        cache.freeStartPtr = cache.freeEndPtr = nullptr;
+    }
+
+    template<int inst, bool threads, bool statistics, typename SizeClasses, typename ChunkSource>
+    typename DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::Stats
+    DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::getStats() {
+        Stats result;
+        std::memset(&result, 0, sizeof(result));
+        CentralLock lock;
+        Cache *caches = threads? cacheList: &globalCache;
+        for(std::size_t i = 0; i <= FREE_LIST_COUNT; ++i) {
+            std::size_t values[ALLOC_COUNTER_COUNT];
+            for(std::size_t counter = 0; counter < ALLOC_COUNTER_COUNT; ++counter) {
+                values[counter] = retiredCounters.get(counter, i);
+                for(Cache *cache = caches; cache; cache = cache->nextCache) {
+                    values[counter] += cache->counters.get(counter, i);
+                }
+            }
+            if(i == FREE_LIST_COUNT) {
+                result.largeAllocations = values[ALLOC_COUNTER_ALLOCATIONS];
+                result.largeDeallocations = values[ALLOC_COUNTER_DEALLOCATIONS];
+                break;
+            }
+            typename Stats::SizeClass &sizeClass = result.sizeClasses[i];
+            sizeClass.objectSize = classSize(i);
+            sizeClass.allocations = values[ALLOC_COUNTER_ALLOCATIONS];
+            sizeClass.hits = values[ALLOC_COUNTER_HITS];
+            sizeClass.refills = values[ALLOC_COUNTER_REFILLS];
+            sizeClass.centralFetches = values[ALLOC_COUNTER_CENTRAL_FETCHES];
+            sizeClass.centralReleases = values[ALLOC_COUNTER_CENTRAL_RELEASES];
+            sizeClass.deallocations = values[ALLOC_COUNTER_DEALLOCATIONS];
+            sizeClass.cachedObjects = values[ALLOC_COUNTER_CACHED_OBJECTS];
+            sizeClass.centralObjects = centralListLengths[i];
+        }
+        result.chunkCount = chunkCount;
+        result.chunkBytes = totalSize;
+        result.mallocFallbacks = mallocFallbacks;
+        for(Cache *cache = caches; cache; cache = cache->nextCache) {
+            ++result.threadCount;
+        }
         return result;
     }
 
-    using DefaultAllocator = DefaultAlloc<0>;
+    template<int inst, bool threads, bool statistics, typename SizeClasses, typename ChunkSource>
+    void DefaultAlloc<inst, threads, statistics, SizeClasses, ChunkSource>::dumpStats(std::FILE *out) {
+        Stats stats = getStats();
+        std::fprintf(out, "chunks: %zu, chunk bytes: %zu, malloc fallbacks: %zu, threads: %zu\n",
+                     stats.chunkCount, stats.chunkBytes, stats.mallocFallbacks, stats.threadCount);
+        std::fprintf(out, "large allocations: %zu, large deallocations: %zu\n",
+                     stats.largeAllocations, stats.largeDeallocations);
+        std::fprintf(out, "%6s %10s %8s %10s %10s %10s %10s %10s\n", "size", "allocs", "hit",
+                     "refills", "fetches", "releases", "frees", "freeBytes");
+        for(std::size_t i = 0; i < FREE_LIST_COUNT; ++i) {
+            const typename Stats::SizeClass &sizeClass = stats.sizeClasses[i];
+            std::fprintf(out, "%6zu %10zu %7.2f%% %10zu %10zu %10zu %10zu %10zu\n",
+                         sizeClass.objectSize, sizeClass.allocations, sizeClass.hitRate() * 100,
+                         sizeClass.refills, sizeClass.centralFetches, sizeClass.centralReleases,
+                         sizeClass.deallocations, sizeClass.freeBytes());
+        }
+        std::fprintf(out, "free list bytes: %zu\n", stats.freeListBytes());
+    }
+
+    // 定义TINYSTL_ALLOC_STATS后,默认的分配器会记录统计信息
+#ifdef TINYSTL_ALLOC_STATS
+    const bool allocStatsEnabled = true;
+#else
+    const bool allocStatsEnabled = false;
+#endif
+
+    using DefaultAllocator = DefaultAlloc<0, false, allocStatsEnabled>;
+    using ThreadCacheAllocator = DefaultAlloc<0, true, allocStatsEnabled>;
 
     template<typename T, typename Alloc=DefaultAllocator>
     class SimpleAlloc {
@@ -257,6 +1122,59 @@ namespace tinystl {
         static void deallocate(T *ptr, std::size_t n) {
             Alloc::deallocate(ptr, sizeof(T) * n);
         }
+
+        // 通过分配器实例分配,静态分配器同样适用
+        static T* allocate(Alloc &alloc) {
+            return static_cast<T *>(alloc.allocate(sizeof(T)));
+        }
+
+        static T* allocate(Alloc &alloc, std::size_t n) {
+            return static_cast<T *>(alloc.allocate(sizeof(T) * n));
+        }
+
+        static void deallocate(Alloc &alloc, T *ptr) {
+            alloc.deallocate(ptr, sizeof(T));
+        }
+
+        static void deallocate(Alloc &alloc, T *ptr, std::size_t n) {
+            alloc.deallocate(ptr, sizeof(T) * n);
+        }
+    };
+
+    // 分配器是否提供reallocate(ptr, oldSize, newSize)
+    template<typename Alloc>
+    struct __HasReallocate {
+    private:
+        template<typename U>
+        static TrueType test(decltype(&U::reallocate));
+        template<typename U>
+        static FalseType test(...);
+
+    public:
+        using Result = decltype(test<Alloc>(nullptr));
+    };
+
+    // 容器通过继承__AllocHolder保存分配器实例,
+    // 利用空基类优化,无状态的分配器不占用空间
+    template<typename Alloc>
+    class __AllocHolder: private Alloc {
+    public:
+        __AllocHolder() = default;
+        explicit __AllocHolder(const Alloc &alloc): Alloc(alloc) {}
+
+        Alloc& _getAlloc() {
+            return *this;
+        }
+
+        const Alloc& _getAlloc() const {
+            return *this;
+        }
+
+        void _swapAlloc(__AllocHolder &other) {
+            Alloc tmp(_getAlloc());
+            _getAlloc() = other._getAlloc();
+            other._getAlloc() = tmp;
+        }
     };
 
     template<typename Alloc>
@@ -286,7 +1204,12 @@ namespace tinystl {
         const static std::size_t extraSize = 8;
     };
 
+    // 定义TINYSTL_THREADS后,容器默认使用带线程缓存的分配器
+#ifdef TINYSTL_THREADS
+    using Alloc = ThreadCacheAllocator;
+#else
     using Alloc = DefaultAllocator;
+#endif
 }
 
 #endif
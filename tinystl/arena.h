@@ -0,0 +1,228 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <new>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+
+namespace tinystl {
+    // 单调增长的内存区,分配只移动指针,释放内存只能通过reset一次性完成
+    class Arena {
+    public:
+        explicit Arena(std::size_t blockSize = 4096):
+            head(nullptr), cursor(nullptr), end(nullptr),
+            blockSize(blockSize), used(0), reserved(0) {}
+
+        Arena(const Arena &) = delete;
+        Arena& operator=(const Arena &) = delete;
+
+        ~Arena() {
+            freeBlocks(nullptr);
+        }
+
+        void* allocate(std::size_t n) {
+            n = roundUp(n);
+            if(static_cast<std::size_t>(end - cursor) < n) {
+                newBlock(n);
+            }
+            char *result = cursor;
+            cursor += n;
+            used += n;
+            return result;
+        }
+
+        // 只有最后一次分配的内存能够被真正回收
+        void deallocate(void *ptr, std::size_t n) {
+            n = roundUp(n);
+            if(static_cast<char *>(ptr) + n == cursor) {
+                cursor -= n;
+                used -= n;
+            }
+        }
+
+        void* reallocate(void *ptr, std::size_t oldSize, std::size_t newSize) {
+            std::size_t oldBytes = roundUp(oldSize);
+            std::size_t newBytes = roundUp(newSize);
+            // 最后一次分配的内存尽量原地扩展
+            if(static_cast<char *>(ptr) + oldBytes == cursor
+               && static_cast<std::size_t>(end - static_cast<char *>(ptr)) >= newBytes) {
+                cursor = static_cast<char *>(ptr) + newBytes;
+                used = used - oldBytes + newBytes;
+                return ptr;
+            }
+            void *result = allocate(newSize);
+            std::memcpy(result, ptr, oldSize < newSize? oldSize: newSize);
+            return result;
+        }
+
+        // 释放所有分配过的内存,只保留最后一个(也是最大的)块以便复用
+        void reset() {
+            if(head) {
+                freeBlocks(head);
+                head->prev = nullptr;
+                reserved = head->size;
+                cursor = reinterpret_cast<char *>(head) + headerSize;
+                end = reinterpret_cast<char *>(head) + head->size;
+            }
+            used = 0;
+        }
+
+        std::size_t usedBytes() const {
+            return used;
+        }
+
+        std::size_t reservedBytes() const {
+            return reserved;
+        }
+
+    private:
+        struct Block {
+            Block *prev;
+            std::size_t size;
+        };
+
+        static const std::size_t ALIGN = alignof(std::max_align_t);
+        static const std::size_t headerSize = (sizeof(Block) + ALIGN - 1) & ~(ALIGN - 1);
+
+        static std::size_t roundUp(std::size_t n) {
+            return (n + ALIGN - 1) & ~(ALIGN - 1);
+        }
+
+        void newBlock(std::size_t n) {
+            // 块大小按几何级数增长,减少大量分配时malloc的次数
+            std::size_t size = head? head->size * 2: blockSize;
+            if(size < n + headerSize) {
+                size = n + headerSize;
+            }
+            Block *block = static_cast<Block *>(std::malloc(size));
+            if(!block) {
+                throw std::bad_alloc();
+            }
+            block->prev = head;
+            block->size = size;
+            head = block;
+            reserved += size;
+            cursor = reinterpret_cast<char *>(block) + headerSize;
+            end = reinterpret_cast<char *>(block) + size;
+        }
+
+        // 释放last之前的所有块
+        void freeBlocks(Block *last) {
+            Block *block = last? last->prev: head;
+            while(block) {
+                Block *prev = block->prev;
+                std::free(block);
+                block = prev;
+            }
+        }
+
+        Block *head;
+        char *cursor;
+        char *end;
+        std::size_t blockSize;
+        std::size_t used;
+        std::size_t reserved;
+    };
+
+    // 使用当前线程绑定的Arena分配内存,可以作为容器的_Alloc参数
+    // 容器必须在Arena被reset或销毁之前析构
+    template<int inst>
+    class ArenaAlloc {
+    public:
+        // 在作用域内把arena绑定到当前线程,离开作用域时恢复之前绑定的arena
+        class Scope {
+        public:
+            explicit Scope(Arena &arena): prev(currentArena) {
+                currentArena = &arena;
+            }
+
+            Scope(const Scope &) = delete;
+            Scope& operator=(const Scope &) = delete;
+
+            ~Scope() {
+                currentArena = prev;
+            }
+
+        private:
+            Arena *prev;
+        };
+
+        static void* allocate(std::size_t n) {
+            if(!currentArena) {
+                throw std::bad_alloc();
+            }
+            return currentArena->allocate(n);
+        }
+
+        static void deallocate(void *ptr, std::size_t n) {
+            if(currentArena) {
+                currentArena->deallocate(ptr, n);
+            }
+        }
+
+        static void* reallocate(void *ptr, std::size_t oldSize, std::size_t newSize) {
+            if(!currentArena) {
+                throw std::bad_alloc();
+            }
+            return currentArena->reallocate(ptr, oldSize, newSize);
+        }
+
+        static Arena* current() {
+            return currentArena;
+        }
+
+    private:
+        static thread_local Arena *currentArena;
+    };
+
+    template<int inst>
+    thread_local Arena *ArenaAlloc<inst>::currentArena = nullptr;
+
+    // 指向某个Arena的分配器实例,由容器各自持有,不依赖当前线程绑定的Arena
+    class ArenaRef {
+    public:
+        ArenaRef(): arena(nullptr) {}
+        explicit ArenaRef(Arena &arena): arena(&arena) {}
+
+        void* allocate(std::size_t n) {
+            if(!arena) {
+                throw std::bad_alloc();
+            }
+            return arena->allocate(n);
+        }
+
+        void deallocate(void *ptr, std::size_t n) {
+            if(arena) {
+                arena->deallocate(ptr, n);
+            }
+        }
+
+        void* reallocate(void *ptr, std::size_t oldSize, std::size_t newSize) {
+            if(!arena) {
+                throw std::bad_alloc();
+            }
+            return arena->reallocate(ptr, oldSize, newSize);
+        }
+
+        Arena* get() const {
+            return arena;
+        }
+
+    private:
+        Arena *arena;
+    };
+
+    inline bool operator==(const ArenaRef &lhs, const ArenaRef &rhs) {
+        return lhs.get() == rhs.get();
+    }
+
+    inline bool operator!=(const ArenaRef &lhs, const ArenaRef &rhs) {
+        return !(lhs == rhs);
+    }
+
+    using ArenaAllocator = ArenaAlloc<0>;
+    using ArenaScope = ArenaAllocator::Scope;
+}
+
+#endif
@@ -0,0 +1,342 @@
+#ifndef CONCURRENT_HASH_MAP_H
+#define CONCURRENT_HASH_MAP_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <thread>
+#include "hashtable.h"
+#include "hash.h"
+#include "algobase.h"
+#include "alloc.h"
+#include "objectpool.h"
+#include "pair.h"
+
+namespace tinystl {
+
+    // 写者优先的读写自旋锁,自旋一段时间后让出CPU
+    // 有写者等待时新的读者不能进入,避免写者饿死
+    class __RWSpinLock {
+    public:
+        __RWSpinLock(): __state(0) {}
+
+        __RWSpinLock(const __RWSpinLock &) = delete;
+        __RWSpinLock& operator=(const __RWSpinLock &) = delete;
+
+        void lockShared() {
+            for(unsigned spins = 0; ; ++spins) {
+                unsigned state = __state.load(std::memory_order_relaxed);
+                if(!(state & (WRITER | WRITER_WAITING)) &&
+                   __state.compare_exchange_weak(state, state + 1, std::memory_order_acquire,
+                                                 std::memory_order_relaxed)) {
+                    return;
+                }
+                _pause(spins);
+            }
+        }
+        void unlockShared() {
+            __state.fetch_sub(1, std::memory_order_release);
+        }
+
+        void lock() {
+            for(unsigned spins = 0; ; ++spins) {
+                unsigned state = __state.load(std::memory_order_relaxed);
+                // 没有读者和写者时获得锁,同时清除等待标记,其它等待的写者会重新设置
+                if(!(state & ~WRITER_WAITING)) {
+                    if(__state.compare_exchange_weak(state, WRITER, std::memory_order_acquire,
+                                                     std::memory_order_relaxed)) {
+                        return;
+                    }
+                } else if(!(state & WRITER_WAITING)) {
+                    __state.fetch_or(WRITER_WAITING, std::memory_order_relaxed);
+                }
+                _pause(spins);
+            }
+        }
+        void unlock() {
+            __state.fetch_and(~WRITER, std::memory_order_release);
+        }
+
+    private:
+        static const unsigned WRITER = 1u << 31;
+        static const unsigned WRITER_WAITING = 1u << 30;
+        static const unsigned SPIN_COUNT = 64;
+
+        static void _pause(unsigned spins) {
+            if(spins >= SPIN_COUNT) {
+                std::this_thread::yield();
+            }
+        }
+
+        std::atomic<unsigned> __state;
+    };
+
+    class __SharedLockGuard {
+    public:
+        explicit __SharedLockGuard(__RWSpinLock &lock): __lock(lock) { __lock.lockShared(); }
+        ~__SharedLockGuard() { __lock.unlockShared(); }
+
+        __SharedLockGuard(const __SharedLockGuard &) = delete;
+        __SharedLockGuard& operator=(const __SharedLockGuard &) = delete;
+
+    private:
+        __RWSpinLock &__lock;
+    };
+
+    class __UniqueLockGuard {
+    public:
+        explicit __UniqueLockGuard(__RWSpinLock &lock): __lock(lock) { __lock.lock(); }
+        ~__UniqueLockGuard() { __lock.unlock(); }
+
+        __UniqueLockGuard(const __UniqueLockGuard &) = delete;
+        __UniqueLockGuard& operator=(const __UniqueLockGuard &) = delete;
+
+    private:
+        __RWSpinLock &__lock;
+    };
+
+    // 按哈希值把键分到shardCount个HashTable分片中,每个分片由自己的读写锁保护,
+    // 不同分片上的操作互不阻塞。分片按cache line对齐,锁之间没有伪共享
+    // 每个接口对单个键(或单个分片)是原子的,size()、clear()和forEach()逐个分片进行,不是整体快照
+    // 不提供迭代器,访问元素都通过回调在持有锁时完成,回调中不能再访问同一个ConcurrentHashMap
+    // 多个线程会同时分配和释放结点,默认使用带线程缓存的分配器
+    template<typename Key, typename T, typename HashFun=Hash<Key>,
+             typename EqualKey=Equal<Key>, typename _Alloc=ThreadCacheAllocator>
+    class ConcurrentHashMap {
+    public:
+        using KeyType = Key;
+        using MappedType = T;
+        using ValueType = Pair<KeyType, MappedType>;
+        using SizeType = std::size_t;
+        using Hasher = HashFun;
+        using KeyEqual = EqualKey;
+
+    protected:
+        struct _KeyOfValue {
+            const KeyType& operator()(const ValueType &value) const {
+                return value.first;
+            }
+        };
+        using _Table = HashTable<ValueType, KeyType, HashFun, _KeyOfValue, EqualKey, _Alloc>;
+
+        struct alignas(CACHE_LINE_SIZE) _Shard {
+            _Shard(const HashFun &hash, const EqualKey &equal)
+                : table(0, equal, _KeyOfValue(), hash) {}
+
+            __RWSpinLock lock;
+            _Table table;
+        };
+
+    private:
+        using __Self = ConcurrentHashMap<Key, T, HashFun, EqualKey, _Alloc>;
+
+    public:
+        // shardCount向上取整为2的幂,通常取并发线程数的几倍
+        explicit ConcurrentHashMap(SizeType shardCount = DEFAULT_SHARD_COUNT,
+                                   const HashFun &hash = HashFun(),
+                                   const EqualKey &equal = EqualKey())
+            : __hasher(hash), __shards(nullptr), __shardCount(1), __shardShift(WORD_BITS) {
+            while(__shardCount < shardCount) {
+                __shardCount <<= 1;
+                --__shardShift;
+            }
+            std::size_t size = sizeof(_Shard) * __shardCount;
+            __shards = static_cast<_Shard *>(MallocChunkSource::allocate(size, alignof(_Shard)));
+            if(!__shards) {
+                throw std::bad_alloc();
+            }
+            SizeType constructed = 0;
+            try {
+                for(; constructed < __shardCount; ++constructed) {
+                    new(__shards + constructed) _Shard(hash, equal);
+                }
+            } catch(...) {
+                _destroyShards(constructed);
+                throw;
+            }
+        }
+
+        ConcurrentHashMap(const __Self &) = delete;
+        __Self& operator=(const __Self &) = delete;
+
+        ~ConcurrentHashMap() {
+            _destroyShards(__shardCount);
+        }
+
+        // key不存在时插入,返回true;存在时赋值,返回false
+        template<typename M>
+        bool insertOrAssign(const KeyType &key, M &&value) {
+            _Shard &shard = _shardOf(key);
+            __UniqueLockGuard guard(shard.lock);
+            typename _Table::Iterator it = shard.table.find(key);
+            if(it != shard.table.end()) {
+                it->second = tinystl::forward<M>(value);
+                return false;
+            }
+            shard.table.emplaceUnique(PiecewiseConstructTag(), key, tinystl::forward<M>(value));
+            return true;
+        }
+
+        // key不存在时插入,返回是否插入
+        bool insert(const ValueType &value) {
+            _Shard &shard = _shardOf(value.first);
+            __UniqueLockGuard guard(shard.lock);
+            return shard.table.insertUnique(value).second;
+        }
+        template<typename... Args>
+        bool tryEmplace(const KeyType &key, Args&&... args) {
+            _Shard &shard = _shardOf(key);
+            __UniqueLockGuard guard(shard.lock);
+            if(shard.table.find(key) != shard.table.end()) {
+                return false;
+            }
+            shard.table.emplaceUnique(PiecewiseConstructTag(), key, tinystl::forward<Args>(args)...);
+            return true;
+        }
+
+        // 找到key时在持有写锁的情况下调用f(MappedType&),返回是否找到
+        template<typename Function>
+        bool findAndApply(const KeyType &key, Function f) {
+            _Shard &shard = _shardOf(key);
+            __UniqueLockGuard guard(shard.lock);
+            typename _Table::Iterator it = shard.table.find(key);
+            if(it == shard.table.end()) {
+                return false;
+            }
+            f(it->second);
+            return true;
+        }
+        // 只读版本,持有读锁,调用f(const MappedType&)
+        template<typename Function>
+        bool findAndApply(const KeyType &key, Function f) const {
+            _Shard &shard = _shardOf(key);
+            __SharedLockGuard guard(shard.lock);
+            typename _Table::ConstIterator it = shard.table.find(key);
+            if(it == shard.table.cend()) {
+                return false;
+            }
+            f(static_cast<const MappedType &>(it->second));
+            return true;
+        }
+
+        // 找到key时把值复制到result
+        bool find(const KeyType &key, MappedType &result) const {
+            return findAndApply(key, [&result](const MappedType &value) { result = value; });
+        }
+        bool contains(const KeyType &key) const {
+            _Shard &shard = _shardOf(key);
+            __SharedLockGuard guard(shard.lock);
+            return shard.table.find(key) != shard.table.cend();
+        }
+
+        bool erase(const KeyType &key) {
+            _Shard &shard = _shardOf(key);
+            __UniqueLockGuard guard(shard.lock);
+            return shard.table.erase(key) != 0;
+        }
+        // key存在且pred(const MappedType&)为真时删除,判断和删除之间不会被其它线程修改
+        template<typename Predicate>
+        bool eraseIf(const KeyType &key, Predicate pred) {
+            _Shard &shard = _shardOf(key);
+            __UniqueLockGuard guard(shard.lock);
+            typename _Table::Iterator it = shard.table.find(key);
+            if(it == shard.table.end() || !pred(static_cast<const MappedType &>(it->second))) {
+                return false;
+            }
+            shard.table.erase(it);
+            return true;
+        }
+        // 删除所有使pred(const ValueType&)为真的元素,返回删除的个数,每个分片内是原子的
+        template<typename Predicate>
+        SizeType eraseIf(Predicate pred) {
+            SizeType result = 0;
+            for(SizeType i = 0; i < __shardCount; ++i) {
+                _Table &table = __shards[i].table;
+                __UniqueLockGuard guard(__shards[i].lock);
+                for(typename _Table::Iterator it = table.begin(); it != table.end();) {
+                    if(pred(static_cast<const ValueType &>(*it))) {
+                        table.erase(it++);
+                        ++result;
+                    } else {
+                        ++it;
+                    }
+                }
+            }
+            return result;
+        }
+
+        // 持有各分片的读锁依次调用f(const ValueType&)
+        template<typename Function>
+        void forEach(Function f) const {
+            for(SizeType i = 0; i < __shardCount; ++i) {
+                const _Table &table = __shards[i].table;
+                __SharedLockGuard guard(__shards[i].lock);
+                for(typename _Table::ConstIterator it = table.cbegin(); it != table.cend(); ++it) {
+                    f(*it);
+                }
+            }
+        }
+
+        void clear() {
+            for(SizeType i = 0; i < __shardCount; ++i) {
+                __UniqueLockGuard guard(__shards[i].lock);
+                __shards[i].table.clear();
+            }
+        }
+
+        SizeType size() const {
+            SizeType result = 0;
+            for(SizeType i = 0; i < __shardCount; ++i) {
+                __SharedLockGuard guard(__shards[i].lock);
+                result += __shards[i].table.size();
+            }
+            return result;
+        }
+        bool empty() const {
+            return size() == 0;
+        }
+
+        // 为每个分片预留count / shardCount()个元素的桶
+        void reserve(SizeType count) {
+            const SizeType perShard = (count + __shardCount - 1) / __shardCount;
+            for(SizeType i = 0; i < __shardCount; ++i) {
+                __UniqueLockGuard guard(__shards[i].lock);
+                __shards[i].table.reserve(perShard);
+            }
+        }
+
+        SizeType shardCount() const { return __shardCount; }
+        Hasher hashFunction() const { return __hasher; }
+
+    protected:
+        // 用哈希值的高位选择分片,和分片内选择桶用到的位不相关
+        _Shard& _shardOf(const KeyType &key) const {
+            if(__shardCount == 1) {
+                return __shards[0];
+            }
+            return __shards[(__hasher(key) * FIBONACCI) >> __shardShift];
+        }
+
+        void _destroyShards(SizeType count) {
+            for(SizeType i = 0; i < count; ++i) {
+                __shards[i].~_Shard();
+            }
+            MallocChunkSource::deallocate(__shards, sizeof(_Shard) * __shardCount);
+        }
+
+    private:
+        static const SizeType DEFAULT_SHARD_COUNT = 16;
+        static const unsigned WORD_BITS = sizeof(SizeType) * 8;
+        static const SizeType FIBONACCI = sizeof(SizeType) == 8?
+            static_cast<SizeType>(11400714819323198485ull): static_cast<SizeType>(2654435769u);
+
+        Hasher __hasher;
+        _Shard *__shards;
+        SizeType __shardCount;
+        unsigned __shardShift;
+    };
+
+}
+
+#endif
@@ -6,14 +6,10 @@
 
 namespace tinystl {
 
-    template<typename T1, typename T2>
-    inline void construct(T1 *ptr, const T2 &value) {
-        new (static_cast<void *>(ptr)) T1(value);
-    }
-
-    template<typename T>
-    inline void construct(T *ptr) {
-        new (static_cast<void *>(ptr)) T;
+    // 用args在ptr处原地构造T,没有参数时进行值初始化
+    template<typename T, typename... Args>
+    inline void construct(T *ptr, Args&&... args) {
+        new (static_cast<void *>(ptr)) T(tinystl::forward<Args>(args)...);
     }
 
     template<typename T>
@@ -27,7 +23,7 @@ namespace tinystl {
     template<typename ForwardIterator>
     inline void destroyAux(ForwardIterator beg, ForwardIterator end, FalseType) {
         while(beg != end) {
-            destroy(&*beg);
+            tinystl::destroy(&*beg);
             ++beg;
         }
     }
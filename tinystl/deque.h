@@ -44,6 +44,7 @@ namespace tinystl {
             __first = other.__first;
             __cur = other.__cur;
             __last = other.__last;
+            return *this;
         }
 
         _Self& operator++() {
@@ -52,6 +53,7 @@ namespace tinystl {
                 _setMapNode(__node + 1);
                 __cur = __first;
             }
+            return *this;
         }
 
         _Self operator++(int) {
@@ -199,17 +201,18 @@ namespace tinystl {
     }
 
     template<typename T, typename _Alloc>
-    class DequeBase {
+    class DequeBase: protected __AllocHolder<_Alloc> {
     public:
         using Iterator = DequeIterator<T, T&, T*>;
         using ConstIterator = DequeIterator<T, const T&, const T*>;
-        DequeBase(): _mapPointer(nullptr), _mapSize(0) {}
-        DequeBase(std::size_t count) {
+        explicit DequeBase(const _Alloc &alloc=_Alloc()): __AllocHolder<_Alloc>(alloc),
+                                                         _mapPointer(nullptr), _mapSize(0) {}
+        DequeBase(std::size_t count, const _Alloc &alloc=_Alloc()): __AllocHolder<_Alloc>(alloc) {
             _initializeMap(count);
         }
         ~DequeBase() {
             if(_mapPointer) {
-                _deallocateNodes(_start.__node, _finish.__node);
+                _deallocateNodes(_start.__node, _finish.__node + 1);
                 _deallocateMap(_mapPointer, _mapSize);
             }
         }
@@ -218,22 +221,24 @@ namespace tinystl {
         using MapAllocator = SimpleAlloc<T*, _Alloc>;
         using NodeAllocator = SimpleAlloc<T, _Alloc>;
 
+        using __AllocHolder<_Alloc>::_getAlloc;
+
         enum { INITIALIZE_MAP_SIZE = 8 };
 
         T* _allocateANode() {
-            return NodeAllocator::allocate(bufferSize(sizeof(T)));
+            return NodeAllocator::allocate(_getAlloc(), bufferSize(sizeof(T)));
         }
 
         void _deallocateANode(T *ptr) {
-            NodeAllocator::deallocate(ptr, bufferSize(sizeof(T)));
+            NodeAllocator::deallocate(_getAlloc(), ptr, bufferSize(sizeof(T)));
         }
 
         T** _allocateMap(std::size_t n) {
-            return MapAllocator::allocate(n);
+            return MapAllocator::allocate(_getAlloc(), n);
         }
 
         void _deallocateMap(T **ptr, std::size_t n) {
-            MapAllocator::deallocate(ptr, n);
+            MapAllocator::deallocate(_getAlloc(), ptr, n);
         }
 
         void _allocateNodes(T **first, T **last) {
@@ -260,7 +265,7 @@ namespace tinystl {
 
         void _initializeMap(std::size_t elementCount) {
             const std::size_t nodesCount = elementCount / bufferSize(sizeof(T)) + 1;
-            _mapSize = max(static_cast<std::size_t>(INITIALIZE_MAP_SIZE), nodesCount + 2);
+            _mapSize = tinystl::max(static_cast<std::size_t>(INITIALIZE_MAP_SIZE), nodesCount + 2);
             _mapPointer = _allocateMap(_mapSize);
             T **first = _mapPointer + (_mapSize - nodesCount) / 2;
             T **last = first + nodesCount;
@@ -319,14 +324,19 @@ namespace tinystl {
 
     public:
         Deque(): _Base(0) {}
-        Deque(SizeType count, const T &value);
-        explicit Deque(SizeType count);
+        explicit Deque(const _Alloc &alloc): _Base(0, alloc) {}
+        Deque(SizeType count, const T &value, const _Alloc &alloc=_Alloc());
+        explicit Deque(SizeType count, const _Alloc &alloc=_Alloc());
         template<typename InputIterator>
-        Deque(InputIterator first, InputIterator last);
+        Deque(InputIterator first, InputIterator last, const _Alloc &alloc=_Alloc());
         Deque(const _Self &other);
+        Deque(_Self &&other);
         ~Deque();
 
+        _Alloc getAllocator() const { return _Base::_getAlloc(); }
+
         _Self& operator=(const _Self &other);
+        _Self& operator=(_Self &&other);
         void assign(SizeType count, const T &value);
         template<typename InputIterator>
         void assign(InputIterator first, InputIterator last);
@@ -360,16 +370,25 @@ namespace tinystl {
 
         void clear() { erase(cbegin(), cend()); }
         Iterator insert(ConstIterator pos, const T &value);
+        Iterator insert(ConstIterator pos, T &&value);
         Iterator insert(ConstIterator pos, SizeType count, const T &value);
         template<typename InputIterator>
         Iterator insert(ConstIterator pos, InputIterator first, InputIterator last);
+        template<typename... Args>
+        Iterator emplace(ConstIterator pos, Args&&... args);
 
         Iterator erase(ConstIterator pos);
         Iterator erase(ConstIterator first, ConstIterator last);
 
         void pushBack(const T &value);
+        void pushBack(T &&value);
+        template<typename... Args>
+        void emplaceBack(Args&&... args);
         void popBack();
         void pushFront(const T &value);
+        void pushFront(T &&value);
+        template<typename... Args>
+        void emplaceFront(Args&&... args);
         void popFront();
         void resize(SizeType count, const T &value);
         void resize(SizeType count);
@@ -384,7 +403,7 @@ namespace tinystl {
         }
 
         void _fillInitialize(SizeType count, const T &value) {
-            uninitializedFill(_start, _finish, value);
+            tinystl::uninitializedFill(_start, _finish, value);
         }
 
         template<typename InputIterator>
@@ -420,8 +439,10 @@ namespace tinystl {
         void _newElementsAtBack(SizeType count);
         void _reallocateMapToAddNodes(SizeType count, bool addAtFront);
 
-        void _pushBackAux(const T &value);
-        void _pushFrontAux(const T &value);
+        template<typename... Args>
+        void _pushBackAux(Args&&... args);
+        template<typename... Args>
+        void _pushFrontAux(Args&&... args);
 
         Iterator _fillInsert(Iterator pos, SizeType count, const T &value);
         Iterator _fillInsertAux(Iterator pos, SizeType count, const T &value);
@@ -450,16 +471,18 @@ namespace tinystl {
     };
 
     template<typename T, typename _Alloc>
-    inline Deque<T, _Alloc>::Deque(SizeType count, const T &value): _Base(count) {
+    inline Deque<T, _Alloc>::Deque(SizeType count, const T &value,
+                                   const _Alloc &alloc): _Base(count, alloc) {
         _fillInitialize(count, value);
     }
 
     template<typename T, typename _Alloc>
-    inline Deque<T, _Alloc>::Deque(SizeType count): Deque(count, T()) {}
+    inline Deque<T, _Alloc>::Deque(SizeType count, const _Alloc &alloc): Deque(count, T(), alloc) {}
 
     template<typename T, typename _Alloc>
     template<typename InputIterator>
-    inline Deque<T, _Alloc>::Deque(InputIterator first, InputIterator last) {
+    inline Deque<T, _Alloc>::Deque(InputIterator first, InputIterator last,
+                                   const _Alloc &alloc): _Base(alloc) {
         _rangeInitialize(first, last);
     }
 
@@ -502,23 +525,41 @@ namespace tinystl {
                                                        ForwardIteratorTag) {
         const SizeType count = tinystl::distance(first, last);
         _initializeMap(count);
-        uninitializedCopy(first, last, _start);
+        tinystl::uninitializedCopy(first, last, _start);
     }
 
     template<typename T, typename _Alloc>
-    inline Deque<T, _Alloc>::Deque(const _Self &other): _Base(other.size()) {
-        uninitializedCopy(other.cbegin(), other.cend(), _start);
+    inline Deque<T, _Alloc>::Deque(const _Self &other): _Base(other.size(), other.getAllocator()) {
+        tinystl::uninitializedCopy(other.cbegin(), other.cend(), _start);
+    }
+
+    // 新分配的空map留给other
+    template<typename T, typename _Alloc>
+    inline Deque<T, _Alloc>::Deque(_Self &&other): _Base(0, other.getAllocator()) {
+        swap(other);
     }
 
     template<typename T, typename _Alloc>
     Deque<T, _Alloc>::~Deque() {
-        destroy(begin(), end());
+        tinystl::destroy(begin(), end());
     }
 
     template<typename T, typename _Alloc>
     inline Deque<T, _Alloc>& Deque<T, _Alloc>::operator=(const Deque<T,
                                                          _Alloc> &other) {
-        assign(other.cbegin(), other.cend());
+        if(this != &other) {
+            assign(other.cbegin(), other.cend());
+        }
+        return *this;
+    }
+
+    template<typename T, typename _Alloc>
+    inline Deque<T, _Alloc>& Deque<T, _Alloc>::operator=(_Self &&other) {
+        if(this != &other) {
+            clear();
+            swap(other);
+        }
+        return *this;
     }
 
     template<typename T, typename _Alloc>
@@ -529,10 +570,10 @@ namespace tinystl {
     template<typename T, typename _Alloc>
     void Deque<T, _Alloc>::_fillAssign(SizeType count, const T &value) {
         if(size() > count) {
-            fillN(begin(), count, value);
+            tinystl::fillN(begin(), count, value);
             erase(begin() + count, end());
         } else {
-            fill(begin(), end(), value);
+            tinystl::fill(begin(), end(), value);
             insert(end(), count - size(), value);
         }
     }
@@ -636,16 +677,16 @@ namespace tinystl {
             newStart = _mapPointer + (_mapSize - newNodeCount) / 2 +
                 (addAtFront? addNodeCount: 0);
             if(newStart < _start.__node) {
-                copy(_start.__node, _finish.__node + 1, newStart);
+                tinystl::copy(_start.__node, _finish.__node + 1, newStart);
             } else {
-                copyBackward(_start.__node, _finish.__node + 1, newStart + oldNodeCount);
+                tinystl::copyBackward(_start.__node, _finish.__node + 1, newStart + oldNodeCount);
             }
         } else {
             const SizeType newMapSize = _mapSize + max(_mapSize, newNodeCount) + 2;
             const MapPointer newMapPointer = _allocateMap(newMapSize);
             newStart = newMapPointer + (newMapSize - newNodeCount) / 2 +
                 (addAtFront? addNodeCount: 0);
-            copy(_start.__node, _finish.__node + 1, newStart);
+            tinystl::copy(_start.__node, _finish.__node + 1, newStart);
 
             _deallocateMap(_mapPointer, _mapSize);
             _mapPointer = newMapPointer;
@@ -671,20 +712,32 @@ namespace tinystl {
 
     template<typename T, typename _Alloc>
     inline void Deque<T, _Alloc>::pushBack(const T &value) {
-        if(_finish.__cur == _finish.__last - 1) {
-            construct(_finish.__cur, value);
+        emplaceBack(value);
+    }
+
+    template<typename T, typename _Alloc>
+    inline void Deque<T, _Alloc>::pushBack(T &&value) {
+        emplaceBack(tinystl::move(value));
+    }
+
+    template<typename T, typename _Alloc>
+    template<typename... Args>
+    inline void Deque<T, _Alloc>::emplaceBack(Args&&... args) {
+        if(_finish.__cur != _finish.__last - 1) {
+            tinystl::construct(_finish.__cur, tinystl::forward<Args>(args)...);
             ++_finish;
         } else {
-            _pushBackAux(value);
+            _pushBackAux(tinystl::forward<Args>(args)...);
         }
     }
 
     template<typename T, typename _Alloc>
-    inline void Deque<T, _Alloc>::_pushBackAux(const T &value) {
+    template<typename... Args>
+    inline void Deque<T, _Alloc>::_pushBackAux(Args&&... args) {
         _reserveMapAtBack(1);
         *(_finish.__node + 1) = _allocateANode();
         try {
-            construct(_finish.__cur, value);
+            tinystl::construct(_finish.__cur, tinystl::forward<Args>(args)...);
         } catch(...) {
             _deallocateANode(*(_finish.__node + 1));
             throw;
@@ -694,21 +747,33 @@ namespace tinystl {
 
     template<typename T, typename _Alloc>
     inline void Deque<T, _Alloc>::pushFront(const T &value) {
+        emplaceFront(value);
+    }
+
+    template<typename T, typename _Alloc>
+    inline void Deque<T, _Alloc>::pushFront(T &&value) {
+        emplaceFront(tinystl::move(value));
+    }
+
+    template<typename T, typename _Alloc>
+    template<typename... Args>
+    inline void Deque<T, _Alloc>::emplaceFront(Args&&... args) {
         if(_start.__cur != _start.__first) {
-            construct(_start.__cur - 1, value);
+            tinystl::construct(_start.__cur - 1, tinystl::forward<Args>(args)...);
             --_start;
         } else {
-            _pushFrontAux(value);
+            _pushFrontAux(tinystl::forward<Args>(args)...);
         }
     }
 
     template<typename T, typename _Alloc>
-    inline void Deque<T, _Alloc>::_pushFrontAux(const T &value) {
+    template<typename... Args>
+    inline void Deque<T, _Alloc>::_pushFrontAux(Args&&... args) {
         _reserveMapAtFront(1);
         *(_start.__node - 1) = _allocateANode();
         T *last = *(_start.__node - 1) + bufferSize(sizeof(T));
         try {
-            construct(last - 1, value);
+            tinystl::construct(last - 1, tinystl::forward<Args>(args)...);
         } catch(...) {
             _deallocateANode(*(_start.__node - 1));
             throw;
@@ -717,29 +782,43 @@ namespace tinystl {
     }
 
     template<typename T, typename _Alloc>
-    typename Deque<T, _Alloc>::Iterator
+    inline typename Deque<T, _Alloc>::Iterator
     Deque<T, _Alloc>::insert(ConstIterator pos, const T &value) {
+        return emplace(pos, value);
+    }
+
+    template<typename T, typename _Alloc>
+    inline typename Deque<T, _Alloc>::Iterator
+    Deque<T, _Alloc>::insert(ConstIterator pos, T &&value) {
+        return emplace(pos, tinystl::move(value));
+    }
+
+    template<typename T, typename _Alloc>
+    template<typename... Args>
+    typename Deque<T, _Alloc>::Iterator
+    Deque<T, _Alloc>::emplace(ConstIterator pos, Args&&... args) {
         if(pos == _start) {
-            pushFront(value);
+            emplaceFront(tinystl::forward<Args>(args)...);
             return _start;
         }
         if(pos == _finish) {
-            pushBack(value);
+            emplaceBack(tinystl::forward<Args>(args)...);
             return _finish - 1;
         }
         DifferenceType index = pos - _start;
-        ValueType valueCopy = value;
+        // 先构造副本,args可能引用容器中会被移动的元素
+        ValueType valueCopy(tinystl::forward<Args>(args)...);
         if(static_cast<SizeType>(index) < size() / 2) {
-            pushFront(front());
+            pushFront(tinystl::move(front()));
             Iterator insertPos = _start + index;
-            copy(_start + 2, insertPos + 1, _start + 1);
-            *insertPos = valueCopy;
+            tinystl::move(_start + 2, insertPos + 1, _start + 1);
+            *insertPos = tinystl::move(valueCopy);
             return insertPos;
         } else {
-            pushBack(back());
+            pushBack(tinystl::move(back()));
             Iterator insertPos = _start + index;
-            copy(insertPos, _finish - 2, _finish - 1);
-            *insertPos = valueCopy;
+            tinystl::moveBackward(insertPos, _finish - 2, _finish - 1);
+            *insertPos = tinystl::move(valueCopy);
             return insertPos;
         }
     }
@@ -752,20 +831,20 @@ namespace tinystl {
         if(frontElementCount < size() / 2) {
             Iterator newStart = _reserveElementAtFront(count);
             if(frontElementCount <= count) {
-                Iterator it = uninitializedCopy(_start, pos, newStart);
-                uninitializedFill(it, _start, value);
-                fill(_start, pos, value);
+                Iterator it = tinystl::uninitializedCopy(_start, pos, newStart);
+                tinystl::uninitializedFill(it, _start, value);
+                tinystl::fill(_start, pos, value);
             } else {
-                uninitializedCopy(_start, _start + count, newStart);
-                copy(_start + count, pos, _start);
-                fill(pos - count, pos, value);
+                tinystl::uninitializedCopy(_start, _start + count, newStart);
+                tinystl::copy(_start + count, pos, _start);
+                tinystl::fill(pos - count, pos, value);
             }
             _start = newStart;
         } else {
             Iterator newFinish = _reserveElementAtBack(count);
-            uninitializedFill(_finish, newFinish, value);
-            copyBackward(pos, _finish, newFinish);
-            fillN(pos, count, value);
+            tinystl::uninitializedFill(_finish, newFinish, value);
+            tinystl::copyBackward(pos, _finish, newFinish);
+            tinystl::fillN(pos, count, value);
             _finish = newFinish;
         }
         return _start + frontElementCount;
@@ -777,13 +856,13 @@ namespace tinystl {
                                   const T &value) {
         if(pos == _start) {
             Iterator newStart = _reserveElementAtFront(count);
-            uninitializedFill(newStart, _start, value);
+            tinystl::uninitializedFill(newStart, _start, value);
             _start = newStart;
             return _start;
         }
         if(pos == _finish) {
             Iterator newFinish = _reserveElementAtBack(count);
-            uninitializedFill(_finish, newFinish, value);
+            tinystl::uninitializedFill(_finish, newFinish, value);
             Iterator ret = _finish;
             _finish = newFinish;
             return ret;
@@ -855,21 +934,21 @@ namespace tinystl {
         if(frontElementCount < size() / 2) {
             Iterator newStart = _reserveElementAtFront(count);
             if(frontElementCount <= count) {
-                Iterator it = uninitializedCopy(_start, pos, newStart);
+                Iterator it = tinystl::uninitializedCopy(_start, pos, newStart);
                 ForwardIterator mid = first + (count - frontElementCount);
-                uninitializedCopy(first, mid, it);
-                copy(mid, last, _start);
+                tinystl::uninitializedCopy(first, mid, it);
+                tinystl::copy(mid, last, _start);
             } else {
-                uninitializedCopy(_start, _start + count, newStart);
-                Iterator it = copy(_start + count, pos, _start);
-                copy(first, last, it);
+                tinystl::uninitializedCopy(_start, _start + count, newStart);
+                Iterator it = tinystl::copy(_start + count, pos, _start);
+                tinystl::copy(first, last, it);
             }
             _start = newStart;
         } else {
             Iterator newFinish = _reserveElementAtBack(count);
-            uninitializedFill(_finish, newFinish, T());
-            copyBackward(pos, _finish, newFinish);
-            copy(first, last, pos);
+            tinystl::uninitializedFill(_finish, newFinish, T());
+            tinystl::copyBackward(pos, _finish, newFinish);
+            tinystl::copy(first, last, pos);
             _finish = newFinish;
         }
         return _start + static_cast<DifferenceType>(frontElementCount);
@@ -886,10 +965,10 @@ namespace tinystl {
     Deque<T, _Alloc>::_erase(Iterator pos) {
         const SizeType frontElementCount = static_cast<SizeType>(pos - _start);
         if(frontElementCount < size() / 2) {
-            copyBackward(_start, pos, pos + 1);
+            tinystl::copyBackward(_start, pos, pos + 1);
             popFront();
         } else {
-            copy(pos + 1, _finish, pos);
+            tinystl::copy(pos + 1, _finish, pos);
             popBack();
         }
         return _start + static_cast<DifferenceType>(frontElementCount);
@@ -907,13 +986,13 @@ namespace tinystl {
         const SizeType frontElementCount = first - _start;
         const SizeType restCount = size() - static_cast<SizeType>(last - first);
         if(frontElementCount < restCount / 2) {
-            Iterator newStart = copyBackward(_start, first, last);
-            destroy(_start, newStart);
+            Iterator newStart = tinystl::copyBackward(_start, first, last);
+            tinystl::destroy(_start, newStart);
             _deallocateNodes(_start.__node, newStart.__node);
             _start = newStart;
         } else {
-            Iterator newFinish = copy(last, _finish, first);
-            destroy(newFinish, _finish);
+            Iterator newFinish = tinystl::copy(last, _finish, first);
+            tinystl::destroy(newFinish, _finish);
             _deallocateNodes(newFinish.__node + 1, _finish.__node + 1);
             _finish = newFinish;
         }
@@ -924,7 +1003,7 @@ namespace tinystl {
     inline void Deque<T, _Alloc>::popBack() {
         if(_finish.__cur != _finish.__first) {
             --_finish.__cur;
-            destroy(_finish.__cur);
+            tinystl::destroy(_finish.__cur);
         } else {
             _popBackAux();
         }
@@ -935,13 +1014,13 @@ namespace tinystl {
         _deallocateANode(*_finish.__node);
         _finish._setMapNode(_finish.__node - 1);
         _finish.__cur = _finish.__last - 1;
-        destroy(_finish.__cur);
+        tinystl::destroy(_finish.__cur);
     }
 
     template<typename T, typename _Alloc>
     inline void Deque<T, _Alloc>::popFront() {
         if(_start.__cur != _start.__last - 1) {
-            destroy(_start.__cur);
+            tinystl::destroy(_start.__cur);
             ++_start.__cur;
         } else {
             _popFrontAux();
@@ -950,7 +1029,7 @@ namespace tinystl {
 
     template<typename T, typename _Alloc>
     inline void Deque<T, _Alloc>::_popFrontAux() {
-        destroy(_start.__cur);
+        tinystl::destroy(_start.__cur);
         _deallocateANode(*_start.__node);
         _start._setMapNode(_start.__node + 1);
         _start.__cur = _start.__first;
@@ -977,12 +1056,13 @@ namespace tinystl {
         tinystl::swap(_mapSize, other._mapSize);
         tinystl::swap(_start, other._start);
         tinystl::swap(_finish, other._finish);
+        _Base::_swapAlloc(other);
     }
 
     template<typename T, typename _Alloc>
     inline bool operator==(const Deque<T, _Alloc> &lhs, const Deque<T, _Alloc> &rhs) {
         return lhs.size() == rhs.size() &&
-            equal(lhs.cbegin(), lhs.cend(), rhs.cbegin());
+            tinystl::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin());
     }
 
     template<typename T, typename _Alloc>
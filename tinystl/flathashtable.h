@@ -0,0 +1,595 @@
+#ifndef FLAT_HASH_TABLE_H
+#define FLAT_HASH_TABLE_H
+
+#include <cstdint>
+#include <cstring>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include "alloc.h"
+#include "hash.h"
+#include "construct.h"
+#include "pair.h"
+#include "iteratortraits.h"
+
+namespace tinystl {
+
+    // 控制字节: 最高位为1表示空槽或已删除的槽,否则低7位是元素哈希值的一部分
+    using __FlatCtrl = signed char;
+    const __FlatCtrl FLAT_EMPTY = -128;
+    const __FlatCtrl FLAT_DELETED = -2;
+    const std::size_t FLAT_GROUP_WIDTH = 16;
+
+    // 一次比较一组16个控制字节,结果的第i位对应组中的第i个槽
+    class __FlatGroup {
+    public:
+#if defined(__SSE2__)
+        explicit __FlatGroup(const __FlatCtrl *ctrl)
+            : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl))) {}
+
+        unsigned match(__FlatCtrl h2) const {
+            return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl)));
+        }
+
+        unsigned matchEmpty() const {
+            return match(FLAT_EMPTY);
+        }
+
+        // 空槽和已删除的槽最高位都是1
+        unsigned matchEmptyOrDeleted() const {
+            return static_cast<unsigned>(_mm_movemask_epi8(ctrl));
+        }
+
+    private:
+        __m128i ctrl;
+#else
+        explicit __FlatGroup(const __FlatCtrl *ctrl): ctrl(ctrl) {}
+
+        unsigned match(__FlatCtrl h2) const {
+            unsigned result = 0;
+            for(std::size_t i = 0; i < FLAT_GROUP_WIDTH; ++i) {
+                result |= static_cast<unsigned>(ctrl[i] == h2) << i;
+            }
+            return result;
+        }
+
+        unsigned matchEmpty() const {
+            return match(FLAT_EMPTY);
+        }
+
+        unsigned matchEmptyOrDeleted() const {
+            unsigned result = 0;
+            for(std::size_t i = 0; i < FLAT_GROUP_WIDTH; ++i) {
+                result |= static_cast<unsigned>(ctrl[i] < 0) << i;
+            }
+            return result;
+        }
+
+    private:
+        const __FlatCtrl *ctrl;
+#endif
+    };
+
+    // 把用户哈希值的高位混入低位,恒等哈希也能均匀地分布到各组
+    inline std::size_t __flatMix(std::size_t hash) {
+        const std::uint64_t x = static_cast<std::uint64_t>(hash) * 0x9e3779b97f4a7c15ull;
+        return static_cast<std::size_t>(x ^ (x >> 32));
+    }
+
+    template<typename Value, typename Ref, typename PointerType>
+    class __FlatHashTableIterator {
+    public:
+        using IteratorCategory = ForwardIteratorTag;
+        using ValueType = Value;
+        using Reference = Ref;
+        using Pointer = PointerType;
+        using SizeType = std::size_t;
+        using DifferenceType = std::ptrdiff_t;
+        using Iterator = __FlatHashTableIterator<Value, Value&, Value*>;
+    private:
+        using __Self = __FlatHashTableIterator<Value, Ref, PointerType>;
+
+    public:
+        __FlatHashTableIterator(): __ctrl(nullptr), __ctrlEnd(nullptr), __slot(nullptr) {}
+        __FlatHashTableIterator(const __FlatCtrl *ctrl, const __FlatCtrl *ctrlEnd, Value *slot)
+            : __ctrl(ctrl), __ctrlEnd(ctrlEnd), __slot(slot) {}
+        __FlatHashTableIterator(const Iterator &other)
+            : __ctrl(other.__ctrl), __ctrlEnd(other.__ctrlEnd), __slot(other.__slot) {}
+        __Self& operator=(const __Self&) = default;
+
+        Iterator removeConst() const {
+            return Iterator(__ctrl, __ctrlEnd, __slot);
+        }
+
+        Reference operator*() const { return *__slot; }
+        Pointer operator->() const { return __slot; }
+        __Self& operator++() {
+            ++__ctrl;
+            ++__slot;
+            _skipEmpty();
+            return *this;
+        }
+        __Self operator++(int) {
+            __Self temp = *this;
+            operator++();
+            return temp;
+        }
+
+        // 跳过空槽和已删除的槽
+        void _skipEmpty() {
+            while(__ctrl != __ctrlEnd && *__ctrl < 0) {
+                ++__ctrl;
+                ++__slot;
+            }
+        }
+
+        const __FlatCtrl *__ctrl;
+        const __FlatCtrl *__ctrlEnd;
+        Value *__slot;
+    };
+
+    template<typename Value, typename LRef, typename LPointer, typename RRef, typename RPointer>
+    inline bool operator==(const __FlatHashTableIterator<Value, LRef, LPointer> &lhs,
+                           const __FlatHashTableIterator<Value, RRef, RPointer> &rhs) {
+        return lhs.__slot == rhs.__slot;
+    }
+
+    template<typename Value, typename LRef, typename LPointer, typename RRef, typename RPointer>
+    inline bool operator!=(const __FlatHashTableIterator<Value, LRef, LPointer> &lhs,
+                           const __FlatHashTableIterator<Value, RRef, RPointer> &rhs) {
+        return !(lhs == rhs);
+    }
+
+    // 开放寻址的哈希表,模板参数和HashTable相同
+    // 元素直接存放在槽数组中,每个槽对应一个控制字节,查找时按组比较控制字节,
+    // 只有低7位哈希值相同的槽才会调用EqualFun
+    // 容量是FLAT_GROUP_WIDTH的2的幂倍,最多使用7/8的槽
+    // 只支持键唯一的元素;插入时可能搬移元素,迭代器和指针失效,删除不会搬移元素
+    template<typename Value, typename Key, typename HashFun,
+             typename ExtractFun, typename EqualFun, typename _Alloc>
+    class FlatHashTable: protected __AllocHolder<_Alloc> {
+    public:
+        using ValueType = Value;
+        using KeyType = Key;
+        using Hash = HashFun;
+        using EqualKey = EqualFun;
+        using ExtractKey = ExtractFun;
+        using Reference = ValueType&;
+        using ConstReference = const ValueType&;
+        using Pointer = ValueType*;
+        using ConstPointer = const ValueType*;
+        using SizeType = std::size_t;
+        using DifferenceType = std::ptrdiff_t;
+    protected:
+        using _CtrlAllocator = SimpleAlloc<__FlatCtrl, _Alloc>;
+        using _SlotAllocator = SimpleAlloc<ValueType, _Alloc>;
+    private:
+        using __Self = FlatHashTable<ValueType, KeyType, Hash, ExtractKey, EqualKey, _Alloc>;
+        using __AllocHolder<_Alloc>::_getAlloc;
+    public:
+        using Iterator = __FlatHashTableIterator<ValueType, Reference, Pointer>;
+        using ConstIterator = __FlatHashTableIterator<ValueType, ConstReference, ConstPointer>;
+
+    public:
+        FlatHashTable(): __ctrl(nullptr), __slots(nullptr), __capacity(0), __count(0),
+                         __growthLeft(0) {}
+        explicit FlatHashTable(const _Alloc &alloc)
+            : __AllocHolder<_Alloc>(alloc), __ctrl(nullptr), __slots(nullptr), __capacity(0),
+              __count(0), __growthLeft(0) {}
+        // bucketCount是预计的元素个数
+        FlatHashTable(SizeType bucketCount, const EqualKey &eql, const ExtractKey &ext,
+                      const Hash &hash, const _Alloc &alloc=_Alloc())
+            : __AllocHolder<_Alloc>(alloc), __ctrl(nullptr), __slots(nullptr), __capacity(0),
+              __count(0), __growthLeft(0), __hasher(hash), __keyExtractor(ext), __equalKey(eql) {
+            resize(bucketCount);
+        }
+        FlatHashTable(const __Self &other)
+            : __AllocHolder<_Alloc>(other.getAllocator()), __ctrl(nullptr), __slots(nullptr),
+              __capacity(0), __count(0), __growthLeft(0), __hasher(other.__hasher),
+              __keyExtractor(other.__keyExtractor), __equalKey(other.__equalKey) {
+            _copyFrom(other);
+        }
+        FlatHashTable(__Self &&other)
+            : __AllocHolder<_Alloc>(other.getAllocator()), __ctrl(other.__ctrl),
+              __slots(other.__slots), __capacity(other.__capacity), __count(other.__count),
+              __growthLeft(other.__growthLeft), __hasher(other.__hasher),
+              __keyExtractor(other.__keyExtractor), __equalKey(other.__equalKey) {
+            other._resetStorage();
+        }
+        __Self& operator=(const __Self &other) {
+            if(this == &other) {
+                return *this;
+            }
+            _destroySlots();
+            _deallocateStorage();
+            _resetStorage();
+            __hasher = other.__hasher;
+            __keyExtractor = other.__keyExtractor;
+            __equalKey = other.__equalKey;
+            _copyFrom(other);
+            return *this;
+        }
+        __Self& operator=(__Self &&other) {
+            if(this != &other) {
+                clear();
+                swap(other);
+            }
+            return *this;
+        }
+        ~FlatHashTable() {
+            _destroySlots();
+            _deallocateStorage();
+        }
+
+        _Alloc getAllocator() const { return _getAlloc(); }
+
+        SizeType size() const { return __count; }
+        SizeType maxSize() const { return static_cast<SizeType>(-1) / sizeof(ValueType); }
+        bool empty() const { return size() == 0; }
+        SizeType bucketCount() const { return __capacity; }
+
+        void swap(__Self &other) {
+            using tinystl::swap;
+            tinystl::swap(__ctrl, other.__ctrl);
+            tinystl::swap(__slots, other.__slots);
+            tinystl::swap(__capacity, other.__capacity);
+            tinystl::swap(__count, other.__count);
+            tinystl::swap(__growthLeft, other.__growthLeft);
+            tinystl::swap(__hasher, other.__hasher);
+            tinystl::swap(__keyExtractor, other.__keyExtractor);
+            tinystl::swap(__equalKey, other.__equalKey);
+            __AllocHolder<_Alloc>::_swapAlloc(other);
+        }
+
+        Iterator begin() {
+            Iterator it(__ctrl, __ctrl + __capacity, __slots);
+            it._skipEmpty();
+            return it;
+        }
+        ConstIterator begin() const {
+            ConstIterator it(__ctrl, __ctrl + __capacity, __slots);
+            it._skipEmpty();
+            return it;
+        }
+        ConstIterator cbegin() const {
+            return begin();
+        }
+        Iterator end() {
+            return _iteratorAt(__capacity);
+        }
+        ConstIterator end() const {
+            return _iteratorAt(__capacity);
+        }
+        ConstIterator cend() const {
+            return end();
+        }
+
+        Pair<Iterator, bool> insertUnique(const ValueType &value) {
+            return _insertUnique(value);
+        }
+        Pair<Iterator, bool> insertUnique(ValueType &&value) {
+            return _insertUnique(tinystl::move(value));
+        }
+        template<typename InputIterator>
+        void insertUnique(InputIterator first, InputIterator last) {
+            while(first != last) {
+                _insertUnique(*first);
+                ++first;
+            }
+        }
+
+        // 不构造出元素就无法得到键,先在栈上构造再移动到槽中
+        template<typename... Args>
+        Pair<Iterator, bool> emplaceUnique(Args&&... args) {
+            ValueType value(tinystl::forward<Args>(args)...);
+            return _insertUnique(tinystl::move(value));
+        }
+
+        Iterator find(const KeyType &key) {
+            return _iteratorAt(_findIndex(key, _hash(key)));
+        }
+        ConstIterator find(const KeyType &key) const {
+            return _iteratorAt(_findIndex(key, _hash(key)));
+        }
+        SizeType count(const KeyType &key) const {
+            return _findIndex(key, _hash(key)) != __capacity? 1: 0;
+        }
+
+        SizeType erase(const KeyType &key) {
+            const SizeType index = _findIndex(key, _hash(key));
+            if(index == __capacity) {
+                return 0;
+            }
+            _eraseIndex(index);
+            return 1;
+        }
+        void erase(Iterator pos) {
+            _eraseIndex(pos.__slot - __slots);
+        }
+        void erase(ConstIterator pos) {
+            erase(pos.removeConst());
+        }
+        // 删除不会搬移其它元素,可以边遍历边删除
+        void erase(Iterator first, Iterator last) {
+            while(first != last) {
+                erase(first++);
+            }
+        }
+        void erase(ConstIterator first, ConstIterator last) {
+            erase(first.removeConst(), last.removeConst());
+        }
+
+        // 保证插入elementCountHint个元素之前不需要扩容
+        void resize(SizeType elementCountHint) {
+            if(elementCountHint < __count) {
+                elementCountHint = __count;
+            }
+            SizeType capacity = FLAT_GROUP_WIDTH;
+            while(_growthCapacity(capacity) < elementCountHint) {
+                capacity *= 2;
+            }
+            if(capacity > __capacity) {
+                _rehash(capacity);
+            }
+        }
+        void clear() {
+            _destroySlots();
+            if(__capacity) {
+                std::memset(__ctrl, FLAT_EMPTY, __capacity);
+            }
+            __count = 0;
+            __growthLeft = _growthCapacity(__capacity);
+        }
+
+        template<typename Value1, typename Key1, typename HashFun1,
+                 typename ExtractFun1, typename EqualFun1, typename _Alloc1>
+        friend bool operator==(const FlatHashTable<Value1, Key1, HashFun1, ExtractFun1,
+                                                   EqualFun1, _Alloc1> &lhs,
+                               const FlatHashTable<Value1, Key1, HashFun1, ExtractFun1,
+                                                   EqualFun1, _Alloc1> &rhs);
+
+    protected:
+        static SizeType _growthCapacity(SizeType capacity) {
+            return capacity - capacity / 8;
+        }
+        static __FlatCtrl _h2(SizeType hash) {
+            return static_cast<__FlatCtrl>(hash & 0x7f);
+        }
+        SizeType _hash(const KeyType &key) const {
+            return __flatMix(__hasher(key));
+        }
+        SizeType _groupMask() const {
+            return __capacity / FLAT_GROUP_WIDTH - 1;
+        }
+
+        Iterator _iteratorAt(SizeType index) {
+            return Iterator(__ctrl + index, __ctrl + __capacity, __slots + index);
+        }
+        ConstIterator _iteratorAt(SizeType index) const {
+            return ConstIterator(__ctrl + index, __ctrl + __capacity, __slots + index);
+        }
+
+        // 按组做三角数探测,组数是2的幂时能访问到所有组
+        // 遇到含有空槽的组就可以停止,返回__capacity表示不存在
+        SizeType _findIndex(const KeyType &key, SizeType hash) const {
+            if(__capacity == 0) {
+                return 0;
+            }
+            const SizeType mask = _groupMask();
+            const __FlatCtrl h2 = _h2(hash);
+            SizeType group = (hash >> 7) & mask;
+            for(SizeType step = 1; ; ++step) {
+                const SizeType base = group * FLAT_GROUP_WIDTH;
+                const __FlatGroup g(__ctrl + base);
+                for(unsigned match = g.match(h2); match; match &= match - 1) {
+                    const SizeType index = base + __countTrailingZeros(match);
+                    if(__equalKey(__keyExtractor(__slots[index]), key)) {
+                        return index;
+                    }
+                }
+                if(g.matchEmpty()) {
+                    return __capacity;
+                }
+                group = (group + step) & mask;
+            }
+        }
+
+        // 探测序列上第一个空槽或已删除的槽
+        SizeType _findInsertIndex(SizeType hash) const {
+            const SizeType mask = _groupMask();
+            SizeType group = (hash >> 7) & mask;
+            for(SizeType step = 1; ; ++step) {
+                const SizeType base = group * FLAT_GROUP_WIDTH;
+                const unsigned match = __FlatGroup(__ctrl + base).matchEmptyOrDeleted();
+                if(match) {
+                    return base + __countTrailingZeros(match);
+                }
+                group = (group + step) & mask;
+            }
+        }
+
+        template<typename Arg>
+        Pair<Iterator, bool> _insertUnique(Arg &&value) {
+            const KeyType &key = __keyExtractor(value);
+            const SizeType hash = _hash(key);
+            SizeType index = _findIndex(key, hash);
+            if(index != __capacity) {
+                return Pair<Iterator, bool>(_iteratorAt(index), false);
+            }
+            // 只有占用新的空槽才会消耗__growthLeft,复用已删除的槽不需要扩容
+            index = __capacity? _findInsertIndex(hash): 0;
+            if(__capacity == 0 || (__growthLeft == 0 && __ctrl[index] == FLAT_EMPTY)) {
+                _rehashForGrowth();
+                index = _findInsertIndex(hash);
+            }
+            tinystl::construct(__slots + index, tinystl::forward<Arg>(value));
+            if(__ctrl[index] == FLAT_EMPTY) {
+                --__growthLeft;
+            }
+            __ctrl[index] = _h2(hash);
+            ++__count;
+            return Pair<Iterator, bool>(_iteratorAt(index), true);
+        }
+
+        void _eraseIndex(SizeType index) {
+            tinystl::destroy(__slots + index);
+            --__count;
+            // 所在的组中还有空槽时,任何查找都不会越过这一组,可以直接标记为空槽
+            const SizeType base = index & ~(FLAT_GROUP_WIDTH - 1);
+            if(__FlatGroup(__ctrl + base).matchEmpty()) {
+                __ctrl[index] = FLAT_EMPTY;
+                ++__growthLeft;
+            } else {
+                __ctrl[index] = FLAT_DELETED;
+            }
+        }
+
+        // 已删除的槽占了大部分空间时按原容量重新整理,否则容量翻倍
+        void _rehashForGrowth() {
+            if(__capacity == 0) {
+                _rehash(FLAT_GROUP_WIDTH);
+            } else if(__count <= _growthCapacity(__capacity) / 2) {
+                _rehash(__capacity);
+            } else {
+                _rehash(__capacity * 2);
+            }
+        }
+
+        void _rehash(SizeType newCapacity) {
+            __FlatCtrl *oldCtrl = __ctrl;
+            ValueType *oldSlots = __slots;
+            const SizeType oldCapacity = __capacity;
+            _allocateStorage(newCapacity);
+            for(SizeType i = 0; i < oldCapacity; ++i) {
+                if(oldCtrl[i] >= 0) {
+                    const SizeType hash = _hash(__keyExtractor(oldSlots[i]));
+                    const SizeType index = _findInsertIndex(hash);
+                    tinystl::construct(__slots + index, tinystl::move(oldSlots[i]));
+                    tinystl::destroy(oldSlots + i);
+                    __ctrl[index] = _h2(hash);
+                }
+            }
+            __growthLeft = _growthCapacity(__capacity) - __count;
+            _deallocateStorage(oldCtrl, oldSlots, oldCapacity);
+        }
+
+        // 分配新的控制字节和槽,全部标记为空槽
+        void _allocateStorage(SizeType capacity) {
+            __FlatCtrl *ctrl = _CtrlAllocator::allocate(_getAlloc(), capacity);
+            ValueType *slots;
+            try {
+                slots = _SlotAllocator::allocate(_getAlloc(), capacity);
+            } catch(...) {
+                _CtrlAllocator::deallocate(_getAlloc(), ctrl, capacity);
+                throw;
+            }
+            std::memset(ctrl, FLAT_EMPTY, capacity);
+            __ctrl = ctrl;
+            __slots = slots;
+            __capacity = capacity;
+        }
+
+        void _deallocateStorage(__FlatCtrl *ctrl, ValueType *slots, SizeType capacity) {
+            if(capacity) {
+                _CtrlAllocator::deallocate(_getAlloc(), ctrl, capacity);
+                _SlotAllocator::deallocate(_getAlloc(), slots, capacity);
+            }
+        }
+        void _deallocateStorage() {
+            _deallocateStorage(__ctrl, __slots, __capacity);
+        }
+
+        void _resetStorage() {
+            __ctrl = nullptr;
+            __slots = nullptr;
+            __capacity = 0;
+            __count = 0;
+            __growthLeft = 0;
+        }
+
+        void _destroySlots() {
+            for(SizeType i = 0; i < __capacity; ++i) {
+                if(__ctrl[i] >= 0) {
+                    tinystl::destroy(__slots + i);
+                }
+            }
+        }
+
+        // 哈希函数相同,每个元素可以放在和other中相同的槽里
+        // 调用前必须没有分配空间
+        void _copyFrom(const __Self &other) {
+            if(other.__capacity == 0) {
+                return;
+            }
+            _allocateStorage(other.__capacity);
+            SizeType i = 0;
+            try {
+                for(; i < __capacity; ++i) {
+                    if(other.__ctrl[i] >= 0) {
+                        tinystl::construct(__slots + i, other.__slots[i]);
+                    }
+                }
+            } catch(...) {
+                while(i-- > 0) {
+                    if(other.__ctrl[i] >= 0) {
+                        tinystl::destroy(__slots + i);
+                    }
+                }
+                _deallocateStorage();
+                _resetStorage();
+                throw;
+            }
+            std::memcpy(__ctrl, other.__ctrl, __capacity);
+            __count = other.__count;
+            __growthLeft = other.__growthLeft;
+        }
+
+    private:
+        __FlatCtrl *__ctrl;
+        ValueType *__slots;
+        SizeType __capacity;
+        SizeType __count;
+        SizeType __growthLeft;
+        Hash __hasher;
+        ExtractKey __keyExtractor;
+        EqualKey __equalKey;
+    };
+
+    // 元素的存放顺序和插入历史有关,逐个在另一张表中查找
+    template<typename Value, typename Key, typename HashFun,
+             typename ExtractFun, typename EqualFun, typename _Alloc>
+    inline bool operator==(const FlatHashTable<Value, Key, HashFun, ExtractFun,
+                                               EqualFun, _Alloc> &lhs,
+                           const FlatHashTable<Value, Key, HashFun, ExtractFun,
+                                               EqualFun, _Alloc> &rhs) {
+        if(lhs.size() != rhs.size()) {
+            return false;
+        }
+        for(auto it = lhs.begin(); it != lhs.end(); ++it) {
+            auto pos = rhs.find(lhs.__keyExtractor(*it));
+            if(pos == rhs.end() || !(*pos == *it)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template<typename Value, typename Key, typename HashFun,
+             typename ExtractFun, typename EqualFun, typename _Alloc>
+    inline bool operator!=(const FlatHashTable<Value, Key, HashFun, ExtractFun,
+                                               EqualFun, _Alloc> &lhs,
+                           const FlatHashTable<Value, Key, HashFun, ExtractFun,
+                                               EqualFun, _Alloc> &rhs) {
+        return !(lhs == rhs);
+    }
+
+    template<typename Value, typename Key, typename HashFun,
+             typename ExtractFun, typename EqualFun, typename _Alloc>
+    inline void swap(FlatHashTable<Value, Key, HashFun, ExtractFun, EqualFun, _Alloc> &lhs,
+                     FlatHashTable<Value, Key, HashFun, ExtractFun, EqualFun, _Alloc> &rhs) {
+        lhs.swap(rhs);
+    }
+
+}
+
+#endif
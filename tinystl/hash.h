@@ -0,0 +1,178 @@
+#ifndef HASH_H
+#define HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace tinystl {
+
+    // 64位整数的混合函数(splitmix64的终结步骤),是双射,每个输入位都会影响所有输出位
+    inline std::uint64_t __hashMix64(std::uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ull;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebull;
+        x ^= x >> 31;
+        return x;
+    }
+
+    // 64位乘法的128位结果,低64位存入a,高64位存入b
+    inline void __hashMultiply(std::uint64_t &a, std::uint64_t &b) {
+#if defined(__SIZEOF_INT128__)
+        unsigned __int128 r = a;
+        r *= b;
+        a = static_cast<std::uint64_t>(r);
+        b = static_cast<std::uint64_t>(r >> 64);
+#else
+        const std::uint64_t ha = a >> 32, hb = b >> 32;
+        const std::uint64_t la = static_cast<std::uint32_t>(a), lb = static_cast<std::uint32_t>(b);
+        const std::uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+        const std::uint64_t t = rl + (rm0 << 32);
+        std::uint64_t carry = t < rl;
+        const std::uint64_t lo = t + (rm1 << 32);
+        carry += lo < t;
+        a = lo;
+        b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif
+    }
+
+    inline std::uint64_t __hashMultiplyMix(std::uint64_t a, std::uint64_t b) {
+        __hashMultiply(a, b);
+        return a ^ b;
+    }
+
+    inline std::uint64_t __hashRead64(const unsigned char *p) {
+        std::uint64_t v;
+        std::memcpy(&v, p, 8);
+        return v;
+    }
+
+    inline std::uint64_t __hashRead32(const unsigned char *p) {
+        std::uint32_t v;
+        std::memcpy(&v, p, 4);
+        return v;
+    }
+
+    // 字节串的哈希值,算法为wyhash
+    // 超过48字节的部分每轮处理48字节,三路乘法互不依赖,可以在流水线中并行执行
+    inline std::uint64_t __hashBytes(const void *data, std::size_t len, std::uint64_t seed = 0) {
+        static const std::uint64_t secret[4] = {
+            0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull,
+            0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull
+        };
+        const unsigned char *p = static_cast<const unsigned char *>(data);
+        seed ^= __hashMultiplyMix(seed ^ secret[0], secret[1]);
+        std::uint64_t a, b;
+        if(len <= 16) {
+            if(len >= 4) {
+                const std::size_t offset = (len >> 3) << 2;
+                a = (__hashRead32(p) << 32) | __hashRead32(p + offset);
+                b = (__hashRead32(p + len - 4) << 32) | __hashRead32(p + len - 4 - offset);
+            } else if(len > 0) {
+                a = (static_cast<std::uint64_t>(p[0]) << 16) |
+                    (static_cast<std::uint64_t>(p[len >> 1]) << 8) | p[len - 1];
+                b = 0;
+            } else {
+                a = b = 0;
+            }
+        } else {
+            std::size_t i = len;
+            if(i > 48) {
+                std::uint64_t seed1 = seed, seed2 = seed;
+                do {
+                    seed = __hashMultiplyMix(__hashRead64(p) ^ secret[1],
+                                             __hashRead64(p + 8) ^ seed);
+                    seed1 = __hashMultiplyMix(__hashRead64(p + 16) ^ secret[2],
+                                              __hashRead64(p + 24) ^ seed1);
+                    seed2 = __hashMultiplyMix(__hashRead64(p + 32) ^ secret[3],
+                                              __hashRead64(p + 40) ^ seed2);
+                    p += 48;
+                    i -= 48;
+                } while(i > 48);
+                seed ^= seed1 ^ seed2;
+            }
+            while(i > 16) {
+                seed = __hashMultiplyMix(__hashRead64(p) ^ secret[1], __hashRead64(p + 8) ^ seed);
+                i -= 16;
+                p += 16;
+            }
+            a = __hashRead64(p + i - 16);
+            b = __hashRead64(p + i - 8);
+        }
+        a ^= secret[1];
+        b ^= seed;
+        __hashMultiply(a, b);
+        return __hashMultiplyMix(a ^ secret[0] ^ len, b ^ secret[1]);
+    }
+
+    // 默认的哈希函数,只为整数、指针和字符串特化
+    template<typename T>
+    struct Hash;
+
+#define MAKE_INTEGER_HASH(T) \
+    template<> \
+    struct Hash<T> { \
+        std::size_t operator()(T value) const { \
+            return static_cast<std::size_t>(__hashMix64(static_cast<std::uint64_t>(value))); \
+        } \
+    }
+
+    MAKE_INTEGER_HASH(bool);
+    MAKE_INTEGER_HASH(char);
+    MAKE_INTEGER_HASH(signed char);
+    MAKE_INTEGER_HASH(unsigned char);
+    MAKE_INTEGER_HASH(wchar_t);
+    MAKE_INTEGER_HASH(char16_t);
+    MAKE_INTEGER_HASH(char32_t);
+    MAKE_INTEGER_HASH(short);
+    MAKE_INTEGER_HASH(unsigned short);
+    MAKE_INTEGER_HASH(int);
+    MAKE_INTEGER_HASH(unsigned int);
+    MAKE_INTEGER_HASH(long);
+    MAKE_INTEGER_HASH(unsigned long);
+    MAKE_INTEGER_HASH(long long);
+    MAKE_INTEGER_HASH(unsigned long long);
+
+#undef MAKE_INTEGER_HASH
+
+    // 按地址计算哈希值
+    template<typename T>
+    struct Hash<T *> {
+        std::size_t operator()(T *ptr) const {
+            return static_cast<std::size_t>(
+                __hashMix64(static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(ptr))));
+        }
+    };
+
+    // C风格字符串按内容计算哈希值
+    template<>
+    struct Hash<const char *> {
+        std::size_t operator()(const char *str) const {
+            return static_cast<std::size_t>(__hashBytes(str, std::strlen(str)));
+        }
+    };
+
+    template<>
+    struct Hash<char *> {
+        std::size_t operator()(const char *str) const {
+            return Hash<const char *>()(str);
+        }
+    };
+
+    // C风格字符串和内容相同的basic_string的哈希值相同,配合Equal<void>查找时不需要构造临时的字符串
+    template<typename CharT, typename Traits, typename Allocator>
+    struct Hash<std::basic_string<CharT, Traits, Allocator>> {
+        using IsTransparent = void;
+
+        std::size_t operator()(const std::basic_string<CharT, Traits, Allocator> &str) const {
+            return static_cast<std::size_t>(__hashBytes(str.data(), str.size() * sizeof(CharT)));
+        }
+        std::size_t operator()(const CharT *str) const {
+            return static_cast<std::size_t>(__hashBytes(str, Traits::length(str) * sizeof(CharT)));
+        }
+    };
+}
+
+#endif
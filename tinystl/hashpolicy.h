@@ -0,0 +1,129 @@
+#ifndef HASH_POLICY_H
+#define HASH_POLICY_H
+
+#include <cstddef>
+#include <cstdint>
+#include "alloc.h"
+
+namespace tinystl {
+
+    // 桶策略决定HashTable的桶数量以及哈希值到桶编号的映射
+    // nextBucketCount(n)返回不小于n的可用桶数量,
+    // 桶数组大小改变后调用reset(bucketCount),之后bucketIndex(hash)返回[0, bucketCount)中的桶编号
+
+    inline const unsigned long* __hashPrimeList() {
+        static const unsigned long primeList[] = {
+            53ul,         97ul,         193ul,       389ul,       769ul,
+            1543ul,       3079ul,       6151ul,      12289ul,     24593ul,
+            49157ul,      98317ul,      196613ul,    393241ul,    786433ul,
+            1572869ul,    3145739ul,    6291469ul,   12582917ul,  25165843ul,
+            50331653ul,   100663319ul,  201326611ul, 402653189ul, 805306457ul,
+            1610612741ul, 3221225473ul, 4294967291ul
+        };
+        return primeList;
+    }
+
+    // 素数个桶,用取模计算桶编号
+    class PrimeBucketPolicy {
+    public:
+        using SizeType = std::size_t;
+
+        PrimeBucketPolicy(): __bucketCount(1) {}
+
+        static SizeType nextBucketCount(SizeType n) {
+            const unsigned long *primeList = __hashPrimeList();
+            int i = 0;
+            while(i < PRIME_COUNT - 1 && primeList[i] < n) {
+                ++i;
+            }
+            return primeList[i];
+        }
+        static SizeType maxBucketCount() {
+            return __hashPrimeList()[PRIME_COUNT - 1];
+        }
+
+        void reset(SizeType bucketCount) {
+            __bucketCount = bucketCount? bucketCount: 1;
+        }
+        SizeType bucketIndex(SizeType hash) const {
+            return hash % __bucketCount;
+        }
+
+    protected:
+        enum { PRIME_COUNT = 28 };
+
+        SizeType __bucketCount;
+    };
+
+    // 素数个桶,用Lemire的fastmod把取模换成两次乘法
+    // 哈希值先折叠为32位,桶数量不超过2^32,结果与对折叠后的值取模相同
+    // 不支持128位整数的平台退化为取模
+    class FastModPrimeBucketPolicy: public PrimeBucketPolicy {
+    public:
+        FastModPrimeBucketPolicy() {
+            reset(1);
+        }
+
+        void reset(SizeType bucketCount) {
+            PrimeBucketPolicy::reset(bucketCount);
+#if defined(__SIZEOF_INT128__)
+            __magic = UINT64_MAX / __bucketCount + 1;
+#endif
+        }
+        SizeType bucketIndex(SizeType hash) const {
+#if defined(__SIZEOF_INT128__)
+            const std::uint64_t h = static_cast<std::uint64_t>(hash);
+            const std::uint32_t folded = static_cast<std::uint32_t>(h ^ (h >> 32));
+            const std::uint64_t lowbits = __magic * folded;
+            return static_cast<SizeType>((static_cast<unsigned __int128>(lowbits) *
+                                          __bucketCount) >> 64);
+#else
+            return hash % __bucketCount;
+#endif
+        }
+
+    private:
+#if defined(__SIZEOF_INT128__)
+        std::uint64_t __magic;
+#endif
+    };
+
+    // 2的幂个桶,用Fibonacci哈希(乘以2^w/黄金分割比后取高位)计算桶编号
+    // 乘法把低位的差异扩散到高位,连续整数之类的弱哈希也能均匀分布
+    class PowerOfTwoBucketPolicy {
+    public:
+        using SizeType = std::size_t;
+
+        PowerOfTwoBucketPolicy(): __shift(WORD_BITS) {}
+
+        static SizeType nextBucketCount(SizeType n) {
+            SizeType count = MIN_BUCKET_COUNT;
+            while(count < n && count < maxBucketCount()) {
+                count <<= 1;
+            }
+            return count;
+        }
+        static SizeType maxBucketCount() {
+            return static_cast<SizeType>(1) << (WORD_BITS - 1);
+        }
+
+        // bucketCount为2的幂,取乘积的高log2(bucketCount)位,桶数量不超过1时总是0
+        void reset(SizeType bucketCount) {
+            __shift = WORD_BITS - (bucketCount > 1? __countTrailingZeros(bucketCount): 0);
+        }
+        // __shift可能等于WORD_BITS,分两次移位避免未定义行为
+        SizeType bucketIndex(SizeType hash) const {
+            return ((hash * FIBONACCI) >> 1) >> (__shift - 1);
+        }
+
+    private:
+        static const unsigned WORD_BITS = sizeof(SizeType) * 8;
+        static const SizeType MIN_BUCKET_COUNT = 16;
+        static const SizeType FIBONACCI = sizeof(SizeType) == 8?
+            static_cast<SizeType>(11400714819323198485ull): static_cast<SizeType>(2654435769u);
+
+        unsigned __shift;
+    };
+}
+
+#endif
@@ -1,13 +1,17 @@
 #ifndef HASH_TABLE_H
 #define HASH_TABLE_H
 
+#include <cmath>
+#include <stdexcept>
 #include "vector.h"
 #include "pair.h"
 #include "alloc.h"
+#include "hash.h"
+#include "hashpolicy.h"
 
 namespace tinystl {
 
-    template<typename Value>
+    template<typename Value, bool cacheHash = false>
     struct __HashTableNode {
         using ValueType = Value;
 
@@ -15,8 +19,88 @@ namespace tinystl {
         __HashTableNode *next;
     };
 
+    // 保存键的完整哈希值,扩容时不需要重新计算,查找时先比较哈希值
+    template<typename Value>
+    struct __HashTableNode<Value, true> {
+        using ValueType = Value;
+
+        ValueType data;
+        __HashTableNode *next;
+        std::size_t hash;
+    };
+
+    // 提示CPU把addr所在的cache line读入缓存,不会产生访存错误
+    inline void __prefetch(const void *addr) {
+#if defined(__GNUC__)
+        __builtin_prefetch(addr);
+#else
+        (void)addr;
+#endif
+    }
+
+    // 桶数组和记录非空桶的位图,遍历时按位图跳过空桶,代价与元素个数而不是桶数量成正比
+    template<typename Node, typename _Alloc>
+    class __HashBuckets {
+    public:
+        using SizeType = std::size_t;
+
+        explicit __HashBuckets(const _Alloc &alloc=_Alloc()): __heads(alloc), __occupied(alloc) {}
+        __HashBuckets(SizeType n, const _Alloc &alloc)
+            : __heads(n, nullptr, alloc), __occupied(_wordCount(n), alloc) {}
+
+        SizeType size() const { return __heads.size(); }
+        bool empty() const { return __heads.empty(); }
+        Node* operator[](SizeType bucketNo) const { return __heads[bucketNo]; }
+        Node* const* slot(SizeType bucketNo) const { return &__heads[bucketNo]; }
+
+        void setHead(SizeType bucketNo, Node *node) {
+            __heads[bucketNo] = node;
+            const SizeType mask = static_cast<SizeType>(1) << (bucketNo % WORD_BITS);
+            if(node) {
+                __occupied[bucketNo / WORD_BITS] |= mask;
+            } else {
+                __occupied[bucketNo / WORD_BITS] &= ~mask;
+            }
+        }
+        // 不小于bucketNo的第一个非空桶,不存在时返回size()
+        SizeType next(SizeType bucketNo) const {
+            SizeType word = bucketNo / WORD_BITS;
+            if(word >= __occupied.size()) {
+                return size();
+            }
+            SizeType bits = __occupied[word] &
+                            (~static_cast<SizeType>(0) << (bucketNo % WORD_BITS));
+            while(!bits) {
+                if(++word == __occupied.size()) {
+                    return size();
+                }
+                bits = __occupied[word];
+            }
+            return word * WORD_BITS + __countTrailingZeros(bits);
+        }
+        void assign(SizeType n) {
+            __heads.assign(n, nullptr);
+            __occupied.assign(_wordCount(n), 0);
+        }
+        void swap(__HashBuckets &other) {
+            tinystl::swap(__heads, other.__heads);
+            tinystl::swap(__occupied, other.__occupied);
+        }
+
+    private:
+        static const SizeType WORD_BITS = sizeof(SizeType) * 8;
+
+        static SizeType _wordCount(SizeType n) {
+            return (n + WORD_BITS - 1) / WORD_BITS;
+        }
+
+        Vector<Node*, _Alloc> __heads;
+        Vector<SizeType, _Alloc> __occupied;
+    };
+
     template<typename Value, typename Key, typename HashFun,
-             typename ExtractFun, typename EqualFun, typename _Alloc>
+             typename ExtractFun, typename EqualFun, typename _Alloc,
+             typename BucketPolicy = PrimeBucketPolicy, bool cacheHash = false>
     class HashTable;
 
     template<typename Value, typename Ref, typename PointerType, typename HashTable>
@@ -32,7 +116,7 @@ namespace tinystl {
                                              typename RemoveConst<Pointer>::ResultType,
                                              HashTable>;
     protected:
-        using _Node = __HashTableNode<Value>;
+        using _Node = typename HashTable::_Node;
         using _HashTable = HashTable;
     private:
         using __Self = __HashTableIterator<Value, Ref, Pointer, HashTable>;
@@ -56,18 +140,11 @@ namespace tinystl {
             if(__node == nullptr) {
                 return *this;
             }
-            _Node *next = __node->next;
-            if(next) {
-                __node = next;
-                return *this;
-            }
-            SizeType currentBucketNo = __hashtable->_computeBucketNoByValueType(__node->data);
-            while(++currentBucketNo < __hashtable->bucketCount() &&
-                  __hashtable->__buckets[currentBucketNo] == nullptr);
-            if(currentBucketNo < __hashtable->bucketCount()) {
-                next = __hashtable->__buckets[currentBucketNo];
+            if(__node->next) {
+                __node = __node->next;
+            } else {
+                __node = __hashtable->_nextBucketNode(__node);
             }
-            __node = next;
             return *this;
         }
         __Self operator++(int) {
@@ -96,15 +173,19 @@ namespace tinystl {
         return !(lhs == rhs);
     }
 
+    // BucketPolicy决定桶数量和桶编号的计算方式,见hashpolicy.h
+    // cacheHash为true时结点保存键的哈希值,适合哈希函数或比较开销较大的键,例如字符串
     template<typename Value, typename Key, typename HashFun,
-             typename ExtractFun, typename EqualFun, typename _Alloc>
-    class HashTable {
+             typename ExtractFun, typename EqualFun, typename _Alloc,
+             typename BucketPolicy, bool cacheHash>
+    class HashTable: protected __AllocHolder<_Alloc> {
     public:
         using ValueType = Value;
         using KeyType = Key;
         using Hash = HashFun;
         using EqualKey = EqualFun;
         using ExtractKey = ExtractFun;
+        using BucketPolicyType = BucketPolicy;
         using Reference = ValueType&;
         using ConstReference = const ValueType&;
         using Pointer = ValueType*;
@@ -112,10 +193,14 @@ namespace tinystl {
         using SizeType = std::size_t;
         using DifferenceType = std::ptrdiff_t;
     protected:
-        using _Node = __HashTableNode<ValueType>;
+        using _Node = __HashTableNode<ValueType, cacheHash>;
+        using _Buckets = __HashBuckets<_Node, _Alloc>;
         using Allocator = SimpleAlloc<_Node, _Alloc>;
     private:
-        using __Self = HashTable<ValueType, KeyType, Hash, ExtractKey, EqualKey, _Alloc>;
+        using __Self = HashTable<ValueType, KeyType, Hash, ExtractKey, EqualKey, _Alloc,
+                                 BucketPolicy, cacheHash>;
+        using __CacheHash = typename BoolType<cacheHash>::Type;
+        using __AllocHolder<_Alloc>::_getAlloc;
     public:
         using Iterator = __HashTableIterator<ValueType, Reference, Pointer, __Self>;
         using ReverseIterator = ReverseIteratorTemplate<Iterator>;
@@ -126,45 +211,95 @@ namespace tinystl {
         friend ConstIterator;
 
     public:
-        HashTable(): __count(0) {}
-        HashTable(SizeType bucketCount, const EqualKey &eql, const ExtractKey &ext, const Hash &hash)
-            : __buckets(bucketCount), __equalKey(eql),
-              __keyExtractor(ext), __hasher(hash) {}
+        HashTable(): __count(0), __migrateNext(0), __rehashStep(0),
+                     __maxLoadFactor(1.0f), __growThreshold(0) {}
+        explicit HashTable(const _Alloc &alloc)
+            : __AllocHolder<_Alloc>(alloc), __buckets(alloc), __count(0),
+              __oldBuckets(alloc), __migrateNext(0), __rehashStep(0),
+              __maxLoadFactor(1.0f), __growThreshold(0) {}
+        HashTable(SizeType bucketCount, const EqualKey &eql, const ExtractKey &ext, const Hash &hash,
+                  const _Alloc &alloc=_Alloc())
+            : __AllocHolder<_Alloc>(alloc),
+              __buckets(BucketPolicy::nextBucketCount(bucketCount), alloc), __count(0),
+              __hasher(hash), __keyExtractor(ext), __equalKey(eql),
+              __oldBuckets(alloc), __migrateNext(0), __rehashStep(0), __maxLoadFactor(1.0f) {
+            _resetBucketPolicy();
+        }
         HashTable(const __Self &other)
-            : __buckets(other.__bucketCount, nullptr), __count(other.__count),
-              __hasher(other.__hasher), __keyExtractor(other.__keyExtrator),
-            __equalKey(other.__equalKey) {
+            : __AllocHolder<_Alloc>(other.getAllocator()),
+              __buckets(other.bucketCount(), other.getAllocator()), __count(other.__count),
+              __hasher(other.__hasher), __keyExtractor(other.__keyExtractor),
+              __equalKey(other.__equalKey), __oldBuckets(other.getAllocator()), __migrateNext(0),
+              __rehashStep(other.__rehashStep), __maxLoadFactor(other.__maxLoadFactor) {
+            _resetBucketPolicy();
             _copyFrom(other);
         }
+        // 接管other的桶和节点,other变为没有桶的空表
+        HashTable(__Self &&other)
+            : __AllocHolder<_Alloc>(other.getAllocator()),
+              __buckets(tinystl::move(other.__buckets)), __count(other.__count),
+              __hasher(other.__hasher), __keyExtractor(other.__keyExtractor),
+              __equalKey(other.__equalKey), __oldBuckets(tinystl::move(other.__oldBuckets)),
+              __migrateNext(other.__migrateNext), __rehashStep(other.__rehashStep),
+              __bucketPolicy(other.__bucketPolicy), __oldBucketPolicy(other.__oldBucketPolicy),
+              __maxLoadFactor(other.__maxLoadFactor), __growThreshold(other.__growThreshold) {
+            other.__count = 0;
+            other.__migrateNext = 0;
+            other.__growThreshold = 0;
+        }
         __Self& operator=(const __Self &other) {
             if(this == &other) {
                 return *this;
             }
             clear();
+            __maxLoadFactor = other.__maxLoadFactor;
             if(bucketCount() < other.bucketCount()) {
-                __buckets.assign(other.bucketCount(), nullptr);
+                __buckets.assign(other.bucketCount());
             }
+            _resetBucketPolicy();
             __count = other.__count;
             __hasher = other.__hasher;
-            __keyExtractor = other.__keyExtrator;
-            __equalKey(other.__equalKey);
+            __keyExtractor = other.__keyExtractor;
+            __equalKey = other.__equalKey;
+            __rehashStep = other.__rehashStep;
             _copyFrom(other);
+            return *this;
+        }
+        __Self& operator=(__Self &&other) {
+            if(this != &other) {
+                clear();
+                swap(other);
+            }
+            return *this;
         }
         ~HashTable() {
             clear();
         }
 
+        _Alloc getAllocator() const { return _getAlloc(); }
+
         SizeType size() const { return __count; }
-        SizeType maxSize() const { return primeList[PRIME_COUNT - 1]; }
+        SizeType maxSize() const { return BucketPolicy::maxBucketCount(); }
         bool empty() const { return size() == 0; }
 
+        Hash hashFunction() const { return __hasher; }
+        EqualKey keyEq() const { return __equalKey; }
+
         void swap(__Self &other) {
             using tinystl::swap;
-            swap(__buckets, other.__buckets);
-            swap(__count, other.__count);
-            swap(__hasher, other.__hasher);
-            swap(__keyExtractor, other.__keyExtractor);
-            swap(__equalKey, other.__equalKey);
+            __buckets.swap(other.__buckets);
+            tinystl::swap(__count, other.__count);
+            tinystl::swap(__hasher, other.__hasher);
+            tinystl::swap(__keyExtractor, other.__keyExtractor);
+            tinystl::swap(__equalKey, other.__equalKey);
+            __oldBuckets.swap(other.__oldBuckets);
+            tinystl::swap(__migrateNext, other.__migrateNext);
+            tinystl::swap(__rehashStep, other.__rehashStep);
+            tinystl::swap(__bucketPolicy, other.__bucketPolicy);
+            tinystl::swap(__oldBucketPolicy, other.__oldBucketPolicy);
+            tinystl::swap(__maxLoadFactor, other.__maxLoadFactor);
+            tinystl::swap(__growThreshold, other.__growThreshold);
+            __AllocHolder<_Alloc>::_swapAlloc(other);
         }
 
         Iterator begin() {
@@ -208,60 +343,112 @@ namespace tinystl {
             return __buckets.size();
         }
         SizeType maxBucketCount() const {
-            return primeList[PRIME_COUNT - 1];
+            return BucketPolicy::maxBucketCount();
         }
+        // 增量迁移过程中还包括旧桶中迁移后会落到bucketNo的结点,需要遍历还没有迁移的旧桶
         SizeType elementCountInSpecificBucket(SizeType bucketNo) const {
             SizeType count = 0;
-            _Node *cur = __buckets[bucketNo];
-            while(cur) {
+            for(_Node *cur = __buckets[bucketNo]; cur; cur = cur->next) {
                 ++count;
-                cur->next;
+            }
+            if(rehashing()) {
+                for(SizeType oldBucketNo = __oldBuckets.next(__migrateNext);
+                    oldBucketNo < __oldBuckets.size(); oldBucketNo = __oldBuckets.next(oldBucketNo + 1)) {
+                    for(_Node *cur = __oldBuckets[oldBucketNo]; cur; cur = cur->next) {
+                        if(__bucketPolicy.bucketIndex(_hashOf(cur)) == bucketNo) {
+                            ++count;
+                        }
+                    }
+                }
             }
             return count;
         }
+        // key在新的桶数组中的桶编号,增量迁移过程中还没有迁移的键迁移后会落到这个桶
+        SizeType bucket(const KeyType &key) const {
+            return __bucketPolicy.bucketIndex(__hasher(key));
+        }
+        float loadFactor() const {
+            return bucketCount() == 0? 0.0f: static_cast<float>(size()) / bucketCount();
+        }
+        // 元素个数超过桶数量的maxLoadFactor倍时扩容,值越小链越短,占用的桶越多
+        float maxLoadFactor() const {
+            return __maxLoadFactor;
+        }
+        void maxLoadFactor(float loadFactor) {
+            if(!(loadFactor > 0.0f)) {
+                throw std::invalid_argument("hashtable max load factor");
+            }
+            __maxLoadFactor = loadFactor;
+            _resetBucketPolicy();
+            if(__count > __growThreshold) {
+                rehash(0);
+            }
+        }
+        // 桶数量至少为bucketCount,并且能容纳当前的元素,桶数量不会减少
+        void rehash(SizeType bucketCount) {
+            _rehashTo(tinystl::max(bucketCount, _bucketCountFor(__count)));
+            _finishRehash();
+        }
+        // 预留能容纳count个元素的桶,之后插入count个元素以内不会扩容
+        void reserve(SizeType count) {
+            rehash(_bucketCountFor(count));
+        }
+
+        // bucketsPerInsert为0时扩容一次完成所有结点的迁移
+        // 否则扩容后保留旧的桶数组,之后每次插入最多迁移bucketsPerInsert个旧桶,
+        // 迁移完成前查找、遍历和删除同时使用两个桶数组
+        void setRehashStep(SizeType bucketsPerInsert) {
+            __rehashStep = bucketsPerInsert;
+            if(bucketsPerInsert == 0) {
+                _finishRehash();
+            }
+        }
+        SizeType rehashStep() const {
+            return __rehashStep;
+        }
+        bool rehashing() const {
+            return !__oldBuckets.empty();
+        }
 
         Pair<Iterator, bool> insertUnique(const ValueType &value) {
             _resizeBuckets(__count + 1);
             return insertUniqueNoResize(value);
         }
+        Pair<Iterator, bool> insertUnique(ValueType &&value) {
+            _resizeBuckets(__count + 1);
+            return insertUniqueNoResize(tinystl::move(value));
+        }
         Iterator insertEqual(const ValueType &value) {
             _resizeBuckets(__count + 1);
             return insertEqualNoResize(value);
         }
+        Iterator insertEqual(ValueType &&value) {
+            _resizeBuckets(__count + 1);
+            return insertEqualNoResize(tinystl::move(value));
+        }
         Pair<Iterator, bool> insertUniqueNoResize(const ValueType &value) {
-            const SizeType bucketNo = _computeBucketNoByValueType(value);
-            _Node *ptr = __buckets[bucketNo];
-            while(ptr) {
-                if(__equalKey(__keyExtractor(ptr->data), __keyExtractor(value))) {
-                    return makePair(Iterator(ptr, this), false);
-                }
-                ptr = ptr->next;
-            }
-            _Node *newNode = _createANode(value);
-            newNode->next = __buckets[bucketNo];
-            __buckets[bucketNo] = newNode;
-            ++__count;
-            return makePair(Iterator(newNode, this), true);
+            return _insertUniqueNoResize(value);
+        }
+        Pair<Iterator, bool> insertUniqueNoResize(ValueType &&value) {
+            return _insertUniqueNoResize(tinystl::move(value));
         }
         Iterator insertEqualNoResize(const ValueType &value) {
-            const SizeType bucketNo = _computeBucketNoByValueType(value);
-            _Node *ptr = __buckets[bucketNo];
-            while(ptr) {
-                if(__equalKey(__keyExtractor(ptr->data), __keyExtractor(value))) {
-                    break;
-                }
-                ptr = ptr->next;
-            }
-            _Node *newNode = _createANode(value);
-            if(ptr) {
-                newNode->next = ptr->next;
-                ptr->next = newNode;
-            } else {
-                newNode->next = __buckets[bucketNo];
-                __buckets[bucketNo] = newNode;
-            }
-            ++__count;
-            return Iterator(newNode, this);
+            return _insertEqualNoResize(value);
+        }
+        Iterator insertEqualNoResize(ValueType &&value) {
+            return _insertEqualNoResize(tinystl::move(value));
+        }
+
+        // 先在结点中构造值再查找,键已经存在时销毁新结点
+        template<typename... Args>
+        Pair<Iterator, bool> emplaceUnique(Args&&... args) {
+            _resizeBuckets(__count + 1);
+            return _insertUniqueNode(_createANode(tinystl::forward<Args>(args)...));
+        }
+        template<typename... Args>
+        Iterator emplaceEqual(Args&&... args) {
+            _resizeBuckets(__count + 1);
+            return _insertEqualNode(_createANode(tinystl::forward<Args>(args)...));
         }
 
         template<typename InputIterator>
@@ -274,83 +461,115 @@ namespace tinystl {
         }
 
         Reference findOrInsert(const ValueType &value) {
+            return *insertUnique(value).first;
         }
         Iterator find(const KeyType &key) {
-            const SizeType bucketNo = _computeBucketNoByKeyType(key);
-            _Node *ptr = __buckets[bucketNo];
-            while(ptr) {
-                if(__equalKey(__keyExtractor(ptr->data), key)) {
-                    return Iterator(ptr, this);
-                }
-                ptr = ptr->next;
-            }
-            return end();
+            return Iterator(_findNode(key), this);
         }
         ConstIterator find(const KeyType &key) const {
-            const SizeType bucketNo = _computeBucketNoByKeyType(key);
-            _Node *ptr = __buckets[bucketNo];
-            while(ptr) {
-                if(__equalKey(__keyExtractor(ptr->data), key)) {
-                    return ConstIterator(ptr, this);
-                }
-                ptr = ptr->next;
-            }
-            return end();
+            return ConstIterator(_findNode(key), this);
         }
         SizeType count(const KeyType &key) const {
             Pair<ConstIterator, ConstIterator> range = equalRange(key);
             return tinystl::distance(range.first, range.second);
         }
-        Pair<Iterator, Iterator>
-        equalRange(const KeyType &key) {
-            SizeType bucketNo = _computeBucketNoByKeyType(key);
-            for(_Node *first = __buckets[bucketNo]; first != nullptr;
-                first = first->next) {
-                if(__equalKey(__keyExtractor(first->data), key)) {
-                    for(_Node *last = first; last != nullptr; last = last->next) {
-                        if(!__equalKey(__keyExtractor(last->data), key)) {
-                            return makePair(Iterator(first, this), Iterator(last, this));
-                        }
-                    }
-                    while(++bucketNo < bucketCount() && __buckets[bucketNo] == nullptr);
-                    if(bucketNo < bucketCount()) {
-                        return makePair(Iterator(first, this),
-                                        Iterator(__buckets[bucketNo], this));
-                    }
-                    return makePair(Iterator(first, this), end());
+
+        // 批量查找,out[i]为keys[i]的查找结果
+        // 一次处理BATCH_SIZE个键,多个键的缓存缺失可以重叠,适合大表上的大量查找
+        void findBatch(const KeyType *keys, SizeType n, Iterator *out) {
+            _Node *nodes[BATCH_SIZE];
+            for(SizeType first = 0; first < n; first += BATCH_SIZE) {
+                const SizeType count = tinystl::min(n - first, SizeType(BATCH_SIZE));
+                _findBatch(keys + first, count, nodes);
+                for(SizeType i = 0; i < count; ++i) {
+                    out[first + i] = Iterator(nodes[i], this);
                 }
             }
-            return makePair(end(), end());
         }
-        Pair<ConstIterator, ConstIterator>
-        equalRange(const KeyType &key) const {
-            SizeType bucketNo = _computeBucketNoByKeyType(key);
-            for(_Node *first = __buckets[bucketNo]; first != nullptr;
-                first = first->next) {
-                if(__equalKey(__keyExtractor(first->data), key)) {
-                    for(_Node *last = first; last != nullptr; last = last->next) {
-                        if(!__equalKey(__keyExtractor(last->data), key)) {
-                            return makePair(ConstIterator(first, this),
-                                            ConstIterator(last, this));
-                        }
-                    }
-                    while(++bucketNo < bucketCount() && __buckets[bucketNo] == nullptr);
-                    if(bucketNo < bucketCount()) {
-                        return makePair(ConstIterator(first, this),
-                                        ConstIterator(__buckets[bucketNo], this));
+        void findBatch(const KeyType *keys, SizeType n, ConstIterator *out) const {
+            _Node *nodes[BATCH_SIZE];
+            for(SizeType first = 0; first < n; first += BATCH_SIZE) {
+                const SizeType count = tinystl::min(n - first, SizeType(BATCH_SIZE));
+                _findBatch(keys + first, count, nodes);
+                for(SizeType i = 0; i < count; ++i) {
+                    out[first + i] = ConstIterator(nodes[i], this);
+                }
+            }
+        }
+        // out[i]为keys[i]的元素个数
+        void countBatch(const KeyType *keys, SizeType n, SizeType *out) const {
+            _Node *nodes[BATCH_SIZE];
+            for(SizeType first = 0; first < n; first += BATCH_SIZE) {
+                const SizeType count = tinystl::min(n - first, SizeType(BATCH_SIZE));
+                _findBatch(keys + first, count, nodes);
+                for(SizeType i = 0; i < count; ++i) {
+                    // 相等的元素是相邻的
+                    SizeType result = 0;
+                    for(_Node *ptr = nodes[i];
+                        ptr && __equalKey(__keyExtractor(ptr->data), keys[first + i]);
+                        ptr = ptr->next) {
+                        ++result;
                     }
-                    return makePair(ConstIterator(first, this), end());
+                    out[first + i] = result;
                 }
             }
-            return makePair(end(), end());
+        }
+        Pair<Iterator, Iterator>
+        equalRange(const KeyType &key) {
+            Pair<ConstIterator, ConstIterator> range =
+                static_cast<const __Self *>(this)->equalRange(key);
+            return makePair(range.first.removeConst(), range.second.removeConst());
+        }
+        Pair<ConstIterator, ConstIterator>
+        equalRange(const KeyType &key) const {
+            return _equalRange(key);
+        }
+
+        // 哈希函数和比较函数都定义了IsTransparent时,可以用任何它们能接受的对象查找,
+        // 不需要构造临时的键。K的哈希值必须和相等的键的哈希值相同
+        template<typename K, typename H = HashFun, typename E = EqualFun,
+                 typename = typename EnableIf<IsTransparent<H>::value &&
+                                              IsTransparent<E>::value>::Type>
+        Iterator find(const K &key) {
+            return Iterator(_findNode(key), this);
+        }
+        template<typename K, typename H = HashFun, typename E = EqualFun,
+                 typename = typename EnableIf<IsTransparent<H>::value &&
+                                              IsTransparent<E>::value>::Type>
+        ConstIterator find(const K &key) const {
+            return ConstIterator(_findNode(key), this);
+        }
+        template<typename K, typename H = HashFun, typename E = EqualFun,
+                 typename = typename EnableIf<IsTransparent<H>::value &&
+                                              IsTransparent<E>::value>::Type>
+        SizeType count(const K &key) const {
+            Pair<ConstIterator, ConstIterator> range = _equalRange(key);
+            return tinystl::distance(range.first, range.second);
+        }
+        template<typename K, typename H = HashFun, typename E = EqualFun,
+                 typename = typename EnableIf<IsTransparent<H>::value &&
+                                              IsTransparent<E>::value>::Type>
+        Pair<Iterator, Iterator> equalRange(const K &key) {
+            Pair<ConstIterator, ConstIterator> range = _equalRange(key);
+            return makePair(range.first.removeConst(), range.second.removeConst());
+        }
+        template<typename K, typename H = HashFun, typename E = EqualFun,
+                 typename = typename EnableIf<IsTransparent<H>::value &&
+                                              IsTransparent<E>::value>::Type>
+        Pair<ConstIterator, ConstIterator> equalRange(const K &key) const {
+            return _equalRange(key);
         }
 
         SizeType erase(const KeyType &key) {
-            const SizeType bucketNo = _computeBucketNoByKeyType(key);
-            _Node *ptr = __buckets[bucketNo];
+            if(empty()) {
+                return 0;
+            }
+            const SizeType hash = __hasher(key);
+            const _BucketRef bucket = _bucketOf(hash);
+            _Node *ptr = bucket.head();
             SizeType count = 0;
             while(ptr) {
-                if(__equalKey(__keyExtractor(ptr->data), key)) {
+                if(_matches(ptr, hash, key)) {
                     _Node *temp = ptr;
                     ptr = ptr->next;
                     _deleteANode(temp);
@@ -359,9 +578,9 @@ namespace tinystl {
                     break;
                 }
             }
-            __buckets[bucketNo] = ptr;
+            bucket.setHead(ptr);
             while(ptr && ptr->next) {
-                if(__equalKey(__keyExtractor(ptr->next->data), key)) {
+                if(_matches(ptr->next, hash, key)) {
                     _Node *temp = ptr->next;
                     ptr->next = temp->next;
                     _deleteANode(temp);
@@ -374,10 +593,10 @@ namespace tinystl {
             return count;
         }
         void erase(Iterator pos) {
-            const SizeType bucketNo = _computeBucketNoByValueType(*pos);
-            _Node *ptr = __buckets[bucketNo];
+            const _BucketRef bucket = _bucketOf(_hashOf(pos.__node));
+            _Node *ptr = bucket.head();
             if(ptr == pos.__node) {
-                __buckets[bucketNo] = ptr->next;
+                bucket.setHead(ptr->next);
                 _deleteANode(ptr);
                 --__count;
                 return;
@@ -389,127 +608,344 @@ namespace tinystl {
                     --__count;
                     return;
                 }
+                ptr = ptr->next;
             }
         }
         void erase(ConstIterator pos) {
             erase(pos.removeConst());
         }
         void erase(Iterator first, Iterator last) {
-            if(first == last) {
-                return;
-            }
-            SizeType elementCount = distance(first, last);
-            SizeType firstBucketNo = _computeBucketNoByValueType(*first);
-            SizeType lastBucketNo = last == end()? bucketCount():
-                _computeBucketNoByValueType(*last);
-            if(firstBucketNo == lastBucketNo) {
-                _eraseBucket(firstBucketNo, first.__node, last.__node);
-            } else {
-                _eraseBucket(firstBucketNo, first.__node, nullptr);
-                while(++firstBucketNo != lastBucketNo) {
-                    _eraseBucket(firstBucketNo);
-                }
-                if(lastBucketNo < bucketCount()) {
-                    _eraseBucket(lastBucketNo, __buckets[lastBucketNo], last.__node);
-                }
+            while(first != last) {
+                erase(first++);
             }
-            __count -= elementCount;
         }
         void erase(ConstIterator first, ConstIterator last) {
             erase(first.removeConst(), last.removeConst());
         }
 
         void resize(SizeType elementCountHint) {
-            _resizeBuckets(elementCountHint);
+            reserve(elementCountHint);
         }
         void clear() {
-            erase(begin(), end());
+            _clearBuckets(__buckets);
+            _clearBuckets(__oldBuckets);
+            _releaseOldBuckets();
+            __count = 0;
         }
 
     protected:
         SizeType _nextSize(SizeType currentSize) const;
-        void _initializeBuckets(SizeType n);
-        SizeType _computeBucketNoByKeyType(const KeyType &key) const {
-            return __hasher(key) % bucketCount();
+        SizeType _hashOf(const _Node *node) const {
+            return _hashOf(node, __CacheHash());
+        }
+        SizeType _hashOf(const _Node *node, TrueType) const {
+            return node->hash;
+        }
+        SizeType _hashOf(const _Node *node, FalseType) const {
+            return __hasher(__keyExtractor(node->data));
+        }
+        void _setHash(_Node *node, SizeType hash) {
+            _setHash(node, hash, __CacheHash());
+        }
+        void _setHash(_Node *node, SizeType hash, TrueType) {
+            node->hash = hash;
         }
-        SizeType _computeBucketNoByValueType(const ValueType &value) const {
-            return __hasher(__keyExtractor(value)) % bucketCount();
+        void _setHash(_Node *, SizeType, FalseType) {}
+        // 缓存了哈希值时先比较哈希值,不同的键大多不需要调用__equalKey
+        template<typename K>
+        bool _matches(const _Node *node, SizeType hash, const K &key) const {
+            return _matches(node, hash, key, __CacheHash());
+        }
+        template<typename K>
+        bool _matches(const _Node *node, SizeType hash, const K &key, TrueType) const {
+            return node->hash == hash && __equalKey(__keyExtractor(node->data), key);
+        }
+        template<typename K>
+        bool _matches(const _Node *node, SizeType, const K &key, FalseType) const {
+            return __equalKey(__keyExtractor(node->data), key);
         }
 
-        _Node* _createANode(const ValueType &value) const {
-            _Node *ptr = Allocator::allocate();
-            construct(&ptr->data, value);
-            return ptr;
+        // 某个桶数组中的一个桶,通过setHead修改头结点以便同时更新位图
+        struct _BucketRef {
+            _Buckets *buckets;
+            SizeType bucketNo;
+
+            _Node* head() const {
+                return (*buckets)[bucketNo];
+            }
+            void setHead(_Node *node) const {
+                buckets->setHead(bucketNo, node);
+            }
+        };
+
+        // 哈希值对应的桶,迁移过程中还没有迁移的旧桶仍然有效
+        // 同一个键的结点总是在同一个桶数组中
+        _BucketRef _bucketOf(SizeType hash) {
+            if(rehashing()) {
+                const SizeType oldBucketNo = __oldBucketPolicy.bucketIndex(hash);
+                if(oldBucketNo >= __migrateNext) {
+                    return _BucketRef{&__oldBuckets, oldBucketNo};
+                }
+            }
+            return _BucketRef{&__buckets, __bucketPolicy.bucketIndex(hash)};
+        }
+        _BucketRef _bucketOf(SizeType hash) const {
+            return const_cast<__Self *>(this)->_bucketOf(hash);
         }
-        void _deleteANode(_Node *ptr) const {
-            destroy(&ptr->data);
-            Allocator::deallocate(ptr);
+        _Node* _bucketHead(SizeType hash) const {
+            return _bucketOf(hash).head();
         }
 
-        void _copyFromSameBucketCount(const __Self &other) {
-            SizeType currentBucketNo = 0;
-            while(currentBucketNo < other.bucketCount()) {
-                _Node *cur = other.__buckets[currentBucketNo];
-                while(cur) {
-                    _Node *newNode = _createANode(cur->data);
-                    newNode->next = __buckets[currentBucketNo];
-                    __buckets[currentBucketNo] = newNode;
-                    cur = cur->next;
+        // 分三轮处理一组键:计算哈希值并预取桶,读取并预取链表头结点,最后比较
+        // 每一轮中各个键的访存互不依赖,缓存缺失可以重叠
+        void _findBatch(const KeyType *keys, SizeType n, _Node **nodes) const {
+            if(empty()) {
+                for(SizeType i = 0; i < n; ++i) {
+                    nodes[i] = nullptr;
                 }
-                ++currentBucketNo;
+                return;
+            }
+            SizeType hashes[BATCH_SIZE];
+            _BucketRef buckets[BATCH_SIZE];
+            for(SizeType i = 0; i < n; ++i) {
+                hashes[i] = __hasher(keys[i]);
+                buckets[i] = _bucketOf(hashes[i]);
+                __prefetch(buckets[i].buckets->slot(buckets[i].bucketNo));
+            }
+            for(SizeType i = 0; i < n; ++i) {
+                nodes[i] = buckets[i].head();
+                if(nodes[i]) {
+                    __prefetch(nodes[i]);
+                }
+            }
+            for(SizeType i = 0; i < n; ++i) {
+                _Node *ptr = nodes[i];
+                while(ptr && !_matches(ptr, hashes[i], keys[i])) {
+                    ptr = ptr->next;
+                }
+                nodes[i] = ptr;
             }
         }
-        void _copyFrom(const __Self &other) {
-            SizeType bucketNo = 0;
-            while(bucketNo < other.bucketCount()) {
-                _Node *cur = other.__buckets[bucketNo];
-                while(cur) {
-                    const SizeType targetBucketNo = _computeBucketNoByValueType(cur->data);
-                    _Node *newNode = _createANode(cur->data);
-                    newNode->next = __buckets[targetBucketNo];
-                    __buckets[targetBucketNo] = newNode;
-                    cur = cur->next;
+
+        template<typename K>
+        _Node* _findNode(const K &key) const {
+            if(empty()) {
+                return nullptr;
+            }
+            const SizeType hash = __hasher(key);
+            _Node *ptr = _bucketHead(hash);
+            while(ptr) {
+                if(_matches(ptr, hash, key)) {
+                    return ptr;
                 }
-                ++bucketNo;
+                ptr = ptr->next;
             }
+            return nullptr;
+        }
+
+        // 相等的元素总是相邻的
+        template<typename K>
+        Pair<ConstIterator, ConstIterator> _equalRange(const K &key) const {
+            ConstIterator first(_findNode(key), this);
+            ConstIterator last = first;
+            while(last != end() && __equalKey(__keyExtractor(*last), key)) {
+                ++last;
+            }
+            return makePair(first, last);
+        }
+
+        // 先遍历新的桶数组,再遍历还没有迁移的旧桶
+        static _Node* _firstNodeFrom(const _Buckets &buckets, SizeType bucketNo) {
+            bucketNo = buckets.next(bucketNo);
+            return bucketNo < buckets.size()? buckets[bucketNo]: nullptr;
         }
         _Node* _getFirstNode() const {
-            SizeType currentBucketNo = 0;
-            while(currentBucketNo < bucketCount()) {
-                if(__buckets[currentBucketNo]) {
-                    return __buckets[currentBucketNo];
+            _Node *first = _firstNodeFrom(__buckets, 0);
+            if(!first && rehashing()) {
+                first = _firstNodeFrom(__oldBuckets, __migrateNext);
+            }
+            return first;
+        }
+        // node所在的桶之后第一个非空桶中的结点
+        _Node* _nextBucketNode(const _Node *node) const {
+            const SizeType hash = _hashOf(node);
+            if(rehashing()) {
+                const SizeType oldBucketNo = __oldBucketPolicy.bucketIndex(hash);
+                if(oldBucketNo >= __migrateNext) {
+                    return _firstNodeFrom(__oldBuckets, oldBucketNo + 1);
                 }
-                ++currentBucketNo;
             }
-            return nullptr;
+            _Node *next = _firstNodeFrom(__buckets, __bucketPolicy.bucketIndex(hash) + 1);
+            if(!next && rehashing()) {
+                next = _firstNodeFrom(__oldBuckets, __migrateNext);
+            }
+            return next;
+        }
+
+        template<typename... Args>
+        _Node* _createANode(Args&&... args) {
+            _Node *ptr = Allocator::allocate(_getAlloc());
+            try {
+                tinystl::construct(&ptr->data, tinystl::forward<Args>(args)...);
+            } catch(...) {
+                Allocator::deallocate(_getAlloc(), ptr);
+                throw;
+            }
+            return ptr;
+        }
+
+        template<typename Arg>
+        Pair<Iterator, bool> _insertUniqueNoResize(Arg &&value) {
+            const SizeType hash = __hasher(__keyExtractor(value));
+            const _BucketRef bucket = _bucketOf(hash);
+            _Node *ptr = bucket.head();
+            while(ptr) {
+                if(_matches(ptr, hash, __keyExtractor(value))) {
+                    return makePair(Iterator(ptr, this), false);
+                }
+                ptr = ptr->next;
+            }
+            _Node *newNode = _createANode(tinystl::forward<Arg>(value));
+            _setHash(newNode, hash);
+            newNode->next = bucket.head();
+            bucket.setHead(newNode);
+            ++__count;
+            return makePair(Iterator(newNode, this), true);
+        }
+        template<typename Arg>
+        Iterator _insertEqualNoResize(Arg &&value) {
+            return _insertEqualNode(_createANode(tinystl::forward<Arg>(value)));
+        }
+        Pair<Iterator, bool> _insertUniqueNode(_Node *newNode) {
+            const SizeType hash = __hasher(__keyExtractor(newNode->data));
+            _setHash(newNode, hash);
+            const _BucketRef bucket = _bucketOf(hash);
+            _Node *ptr = bucket.head();
+            while(ptr) {
+                if(_matches(ptr, hash, __keyExtractor(newNode->data))) {
+                    _deleteANode(newNode);
+                    return makePair(Iterator(ptr, this), false);
+                }
+                ptr = ptr->next;
+            }
+            newNode->next = bucket.head();
+            bucket.setHead(newNode);
+            ++__count;
+            return makePair(Iterator(newNode, this), true);
+        }
+        // 相等的元素放在一起
+        Iterator _insertEqualNode(_Node *newNode) {
+            const SizeType hash = __hasher(__keyExtractor(newNode->data));
+            _setHash(newNode, hash);
+            const _BucketRef bucket = _bucketOf(hash);
+            _Node *ptr = bucket.head();
+            while(ptr) {
+                if(_matches(ptr, hash, __keyExtractor(newNode->data))) {
+                    break;
+                }
+                ptr = ptr->next;
+            }
+            if(ptr) {
+                newNode->next = ptr->next;
+                ptr->next = newNode;
+            } else {
+                newNode->next = bucket.head();
+                bucket.setHead(newNode);
+            }
+            ++__count;
+            return Iterator(newNode, this);
+        }
+        void _deleteANode(_Node *ptr) {
+            tinystl::destroy(&ptr->data);
+            Allocator::deallocate(_getAlloc(), ptr);
+        }
+
+        // 桶数量不小于other时逐个插入,相等的元素仍然相邻
+        void _copyFrom(const __Self &other) {
+            for(ConstIterator it = other.begin(); it != other.end(); ++it) {
+                const SizeType hash = other._hashOf(it.__node);
+                _Node *newNode = _createANode(*it);
+                _setHash(newNode, hash);
+                const SizeType bucketNo = __bucketPolicy.bucketIndex(hash);
+                newNode->next = __buckets[bucketNo];
+                __buckets.setHead(bucketNo, newNode);
+            }
+        }
+        SizeType _bucketCountFor(SizeType elementCount) const {
+            return static_cast<SizeType>(
+                std::ceil(elementCount / static_cast<double>(__maxLoadFactor)));
+        }
+        // 桶数组或maxLoadFactor改变后调用
+        void _resetBucketPolicy() {
+            __bucketPolicy.reset(bucketCount());
+            __growThreshold = static_cast<SizeType>(bucketCount() *
+                                                    static_cast<double>(__maxLoadFactor));
         }
         void _resizeBuckets(const SizeType newElementCount) {
-            if(bucketCount() >= newElementCount) {
+            _migrateBuckets(__rehashStep);
+            if(newElementCount > __growThreshold) {
+                _rehashTo(_bucketCountFor(newElementCount));
+            }
+        }
+        // 桶数量增加到不小于n,rehashStep不为0时结点的迁移分摊到之后的插入中
+        void _rehashTo(SizeType n) {
+            _finishRehash();
+            const SizeType newSize = BucketPolicy::nextBucketCount(n);
+            if(newSize <= bucketCount()) {
                 return;
             }
-            int i = 0;
-            while(i < PRIME_COUNT) {
-                if(primeList[i] >= newElementCount) {
-                    break;
+            _Buckets newBuckets(newSize, _getAlloc());
+            __buckets.swap(newBuckets);
+            __oldBuckets.swap(newBuckets);
+            __oldBucketPolicy = __bucketPolicy;
+            _resetBucketPolicy();
+            __migrateNext = 0;
+            if(__rehashStep == 0) {
+                _finishRehash();
+            }
+        }
+        // 把最多n个旧桶中的结点迁移到新的桶数组
+        void _migrateBuckets(SizeType n) {
+            if(!rehashing()) {
+                return;
+            }
+            for(; n > 0 && __migrateNext < __oldBuckets.size(); --n, ++__migrateNext) {
+                _Node *ptr = __oldBuckets[__migrateNext];
+                if(!ptr) {
+                    continue;
                 }
-                ++i;
-            }
-            i = tinystl::min(PRIME_COUNT - 1, i);
-            const SizeType newSize = primeList[i];
-            Vector<_Node*, _Alloc> newBuckets(newSize, nullptr);
-            for(SizeType currentBucketNo = 0; currentBucketNo < bucketCount();
-                ++currentBucketNo) {
-                _Node *ptr = __buckets[currentBucketNo];
+                __oldBuckets.setHead(__migrateNext, nullptr);
                 while(ptr) {
                     _Node *temp = ptr;
                     ptr = ptr->next;
-                    const SizeType targetBucketNo = _computeBucketNoByValueType(temp->data);
-                    temp->next = newBuckets[targetBucketNo];
-                    newBuckets[targetBucketNo] = temp;
+                    const SizeType bucketNo = __bucketPolicy.bucketIndex(_hashOf(temp));
+                    temp->next = __buckets[bucketNo];
+                    __buckets.setHead(bucketNo, temp);
                 }
             }
-            using tinystl::swap;
-            swap(__buckets, newBuckets);
+            if(__migrateNext == __oldBuckets.size()) {
+                _releaseOldBuckets();
+            }
+        }
+        void _finishRehash() {
+            _migrateBuckets(__oldBuckets.size());
+        }
+        void _releaseOldBuckets() {
+            _Buckets empty(_getAlloc());
+            __oldBuckets.swap(empty);
+            __migrateNext = 0;
+        }
+        void _clearBuckets(_Buckets &buckets) {
+            for(SizeType bucketNo = buckets.next(0); bucketNo < buckets.size();
+                bucketNo = buckets.next(bucketNo + 1)) {
+                _Node *ptr = buckets[bucketNo];
+                while(ptr) {
+                    _Node *next = ptr->next;
+                    _deleteANode(ptr);
+                    ptr = next;
+                }
+                buckets.setHead(bucketNo, nullptr);
+            }
         }
 
         template<typename InputIterator>
@@ -548,7 +984,8 @@ namespace tinystl {
             }
         }
         template<typename ForwardIterator>
-        void _rangeInsertEqualAux(ForwardIterator first, ForwardIterator last) {
+        void _rangeInsertEqualAux(ForwardIterator first, ForwardIterator last,
+                                  ForwardIteratorTag) {
             _resizeBuckets(__count + tinystl::distance(first, last));
             while(first != last) {
                 insertEqualNoResize(*first);
@@ -556,75 +993,74 @@ namespace tinystl {
             }
         }
 
-        void _deleteAListNode(_Node *first, _Node *last) {
-            while(first != last) {
-                _deleteANode(first);
-                first = first->next;
-            }
-        }
-
-        void _eraseBucket(SizeType bucketNo, _Node *first, _Node *last) {
-            _Node *ptr = __buckets[bucketNo];
-            if(ptr == first) {
-                __buckets[bucketNo] = last;
-            } else {
-                while(ptr && ptr->next != first) {
-                    ptr = ptr->next;
-                }
-                ptr->next = last;
-            }
-            _deleteAListNode(first, last);
-        }
-        void _eraseBucket(SizeType bucketNo) {
-            _eraseBucket(bucketNo, __buckets[bucketNo], nullptr);
-        }
-
     private:
-        Vector<_Node*, _Alloc> __buckets;
+        _Buckets __buckets;
         SizeType __count;
         Hash __hasher;
         ExtractKey __keyExtractor;
         EqualKey __equalKey;
+        // 增量迁移时旧的桶数组,[0, __migrateNext)中的桶已经迁移完成
+        _Buckets __oldBuckets;
+        SizeType __migrateNext;
+        SizeType __rehashStep;
+        BucketPolicy __bucketPolicy;
+        BucketPolicy __oldBucketPolicy;
+        float __maxLoadFactor;
+        // 不扩容时最多能容纳的元素个数
+        SizeType __growThreshold;
 
-        enum { PRIME_COUNT = 28 };
-        static const unsigned long primeList[PRIME_COUNT];
-    };
+        // 批量查找时每轮处理的键数
+        enum { BATCH_SIZE = 16 };
 
-    template<typename Value, typename Key, typename HashFun,
-             typename ExtractFun, typename EqualFun, typename _Alloc>
-    const unsigned long HashTable<Value, Key, HashFun, ExtractFun,
-                                  EqualFun, _Alloc>::primeList[PRIME_COUNT] = {
-        53ul,         97ul,         193ul,       389ul,       769ul,
-        1543ul,       3079ul,       6151ul,      12289ul,     24593ul,
-        49157ul,      98317ul,      196613ul,    393241ul,    786433ul,
-        1572869ul,    3145739ul,    6291469ul,   12582917ul,  25165843ul,
-        50331653ul,   100663319ul,  201326611ul, 402653189ul, 805306457ul, 
-        1610612741ul, 3221225473ul, 4294967291ul
+        template<typename Value1, typename Key1, typename HashFun1, typename ExtractFun1,
+                 typename EqualFun1, typename _Alloc1, typename BucketPolicy1, bool cacheHash1>
+        friend bool operator==(const HashTable<Value1, Key1, HashFun1, ExtractFun1, EqualFun1,
+                                               _Alloc1, BucketPolicy1, cacheHash1> &lhs,
+                               const HashTable<Value1, Key1, HashFun1, ExtractFun1, EqualFun1,
+                                               _Alloc1, BucketPolicy1, cacheHash1> &rhs);
     };
 
     template<typename Value, typename Key, typename HashFun,
-             typename ExtractFun, typename EqualFun, typename _Alloc>
+             typename ExtractFun, typename EqualFun, typename _Alloc,
+             typename BucketPolicy, bool cacheHash>
     inline bool operator==(const HashTable<Value, Key, HashFun, ExtractFun,
-                           EqualFun, _Alloc> &lhs,
+                           EqualFun, _Alloc, BucketPolicy, cacheHash> &lhs,
                            const HashTable<Value, Key, HashFun, ExtractFun,
-                           EqualFun, _Alloc> &rhs) {
-        return lhs.size() == rhs.size() &&
-            equal(lhs.begin(), lhs.end(), rhs.begin());
+                           EqualFun, _Alloc, BucketPolicy, cacheHash> &rhs) {
+        if(lhs.size() != rhs.size()) {
+            return false;
+        }
+        // 两个表的遍历顺序可能不同,逐个比较每个键对应的一段元素
+        for(auto it = lhs.begin(); it != lhs.end();) {
+            auto lhsRange = lhs.equalRange(lhs.__keyExtractor(*it));
+            auto rhsRange = rhs.equalRange(lhs.__keyExtractor(*it));
+            if(tinystl::distance(lhsRange.first, lhsRange.second) !=
+               tinystl::distance(rhsRange.first, rhsRange.second) ||
+               !tinystl::isPermutation(lhsRange.first, lhsRange.second, rhsRange.first)) {
+                return false;
+            }
+            it = lhsRange.second;
+        }
+        return true;
     }
 
     template<typename Value, typename Key, typename HashFun,
-             typename ExtractFun, typename EqualFun, typename _Alloc>
+             typename ExtractFun, typename EqualFun, typename _Alloc,
+             typename BucketPolicy, bool cacheHash>
     inline bool operator!=(const HashTable<Value, Key, HashFun, ExtractFun,
-                           EqualFun, _Alloc> &lhs,
+                           EqualFun, _Alloc, BucketPolicy, cacheHash> &lhs,
                            const HashTable<Value, Key, HashFun, ExtractFun,
-                           EqualFun, _Alloc> &rhs) {
+                           EqualFun, _Alloc, BucketPolicy, cacheHash> &rhs) {
         return !(lhs == rhs);
     }
 
     template<typename Value, typename Key, typename HashFun,
-             typename ExtractFun, typename EqualFun, typename _Alloc>
-    inline void swap(HashTable<Value, Key, HashFun, ExtractFun, EqualFun, _Alloc> &lhs,
-              HashTable<Value, Key, HashFun, ExtractFun, EqualFun, _Alloc> &rhs) {
+             typename ExtractFun, typename EqualFun, typename _Alloc,
+             typename BucketPolicy, bool cacheHash>
+    inline void swap(HashTable<Value, Key, HashFun, ExtractFun, EqualFun,
+                     _Alloc, BucketPolicy, cacheHash> &lhs,
+                     HashTable<Value, Key, HashFun, ExtractFun, EqualFun,
+                     _Alloc, BucketPolicy, cacheHash> &rhs) {
         lhs.swap(rhs);
     }
 
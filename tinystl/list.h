@@ -64,6 +64,7 @@ namespace tinystl {
     inline ListIterator<T, Ref, PointerType>&
     ListIterator<T, Ref, PointerType>::operator=(const ListIterator<T, typename RemoveConst<Ref>::ResultType, typename RemoveConst<PointerType>::ResultType> &other) {
         __node = other.__node;
+        return *this;
     }
 
     template<typename T, typename Ref, typename PointerType>
@@ -125,7 +126,7 @@ namespace tinystl {
     // ----------------------------------------------------------------------
     // List class
     template<typename T, typename Alloc=Alloc>
-    class List {
+    class List: protected __AllocHolder<Alloc> {
     public:
         using ValueType = T;
         using SizeType = std::size_t;
@@ -142,17 +143,23 @@ namespace tinystl {
 
     protected:
         using _Self = List<T, Alloc>;
+        using _AllocHolder = __AllocHolder<Alloc>;
 
     public:
         List();
-        List(SizeType count, const T &value);
-        List(SizeType count);
+        explicit List(const Alloc &alloc);
+        List(SizeType count, const T &value, const Alloc &alloc=Alloc());
+        List(SizeType count, const Alloc &alloc=Alloc());
         template<typename InputIterator>
-        List(InputIterator first, InputIterator last);
+        List(InputIterator first, InputIterator last, const Alloc &alloc=Alloc());
         List(const _Self &other);
+        List(_Self &&other);
         ~List();
 
+        Alloc getAllocator() const { return _AllocHolder::_getAlloc(); }
+
         _Self& operator=(const _Self &other);
+        _Self& operator=(_Self &&other);
 
         void assign(SizeType count, const T &value);
         template<typename InputIterator>
@@ -183,17 +190,26 @@ namespace tinystl {
         void clear() { erase(cbegin(), cend()); };
 
         Iterator insert(ConstIterator pos, const T &value);
+        Iterator insert(ConstIterator pos, T &&value);
         Iterator insert(ConstIterator pos, SizeType count, const T &value);
         template<typename InputIterator>
         Iterator insert(ConstIterator pos, InputIterator first, InputIterator last);
+        template<typename... Args>
+        Iterator emplace(ConstIterator pos, Args&&... args);
 
         Iterator erase(ConstIterator pos);
         Iterator erase(ConstIterator first, ConstIterator last);
 
         void pushBack(const T &value);
+        void pushBack(T &&value);
+        template<typename... Args>
+        void emplaceBack(Args&&... args);
         void popBack();
 
         void pushFront(const T &value);
+        void pushFront(T &&value);
+        template<typename... Args>
+        void emplaceFront(Args&&... args);
         void popFront();
 
         void resize(SizeType count);
@@ -252,28 +268,40 @@ namespace tinystl {
     };
 
     template<typename T, typename Alloc>
-    inline List<T, Alloc>::List() {
+    inline List<T, Alloc>::List(): List(Alloc()) {}
+
+    template<typename T, typename Alloc>
+    inline List<T, Alloc>::List(const Alloc &alloc): _AllocHolder(alloc) {
         __node = _createANode();
         __node->prev = __node;
         __node->next = __node;
     }
 
     template<typename T, typename Alloc>
-    inline List<T, Alloc>::List(SizeType count, const T &value): List() {
+    inline List<T, Alloc>::List(SizeType count, const T &value,
+                                const Alloc &alloc): List(alloc) {
         insert(cend(), count, value);
     }
 
     template<typename T, typename Alloc>
-    inline List<T, Alloc>::List(SizeType count): List(count, T()) {}
+    inline List<T, Alloc>::List(SizeType count, const Alloc &alloc): List(count, T(), alloc) {}
 
     template<typename T, typename Alloc>
     template<typename InputIterator>
-    inline List<T, Alloc>::List(InputIterator first, InputIterator last): List() {
+    inline List<T, Alloc>::List(InputIterator first, InputIterator last,
+                                const Alloc &alloc): List(alloc) {
         insert(cend(), first, last);
     }
 
     template<typename T, typename Alloc>
-    inline List<T, Alloc>::List(const _Self &other): List(other.cbegin(), other.cend()) {}
+    inline List<T, Alloc>::List(const _Self &other): List(other.cbegin(), other.cend(),
+                                                          other.getAllocator()) {}
+
+    // 新的头结点留给other,other变为空
+    template<typename T, typename Alloc>
+    inline List<T, Alloc>::List(_Self &&other): List(other.getAllocator()) {
+        swap(other);
+    }
 
     template<typename T, typename Alloc>
     inline List<T, Alloc>::~List() {
@@ -284,7 +312,20 @@ namespace tinystl {
     template<typename T, typename Alloc>
     inline List<T, Alloc>&
     List<T, Alloc>::operator=(const _Self &other) {
-        assign(other.cbegin(), other.cend());
+        if(this != &other) {
+            assign(other.cbegin(), other.cend());
+        }
+        return *this;
+    }
+
+    template<typename T, typename Alloc>
+    inline List<T, Alloc>&
+    List<T, Alloc>::operator=(_Self &&other) {
+        if(this != &other) {
+            clear();
+            swap(other);
+        }
+        return *this;
     }
 
     template<typename T, typename Alloc>
@@ -336,8 +377,26 @@ namespace tinystl {
     template<typename T, typename Alloc>
     inline typename List<T, Alloc>::Iterator
     List<T, Alloc>::insert(ConstIterator pos, const T &value) {
+        return emplace(pos, value);
+    }
+
+    template<typename T, typename Alloc>
+    inline typename List<T, Alloc>::Iterator
+    List<T, Alloc>::insert(ConstIterator pos, T &&value) {
+        return emplace(pos, tinystl::move(value));
+    }
+
+    template<typename T, typename Alloc>
+    template<typename... Args>
+    inline typename List<T, Alloc>::Iterator
+    List<T, Alloc>::emplace(ConstIterator pos, Args&&... args) {
         ListNode<T> *newNode = _createANode();
-        newNode->data = value;
+        try {
+            tinystl::construct(&newNode->data, tinystl::forward<Args>(args)...);
+        } catch(...) {
+            _releaseANode(newNode);
+            throw;
+        }
         newNode->prev = pos.__node->prev;
         pos.__node->prev->next = newNode;
         pos.__node->prev = newNode;
@@ -422,7 +481,7 @@ namespace tinystl {
         Iterator res(cur->next);
         cur->prev->next = cur->next;
         cur->next->prev = cur->prev;
-        destroy(&cur->data);
+        tinystl::destroy(&cur->data);
         _releaseANode(cur);
         return res;
     }
@@ -438,7 +497,7 @@ namespace tinystl {
         while(first != last) {
             ConstIterator next = first;
             ++next;
-            destroy(&first.__node->data);
+            tinystl::destroy(&first.__node->data);
             _releaseANode(first.__node);
             first = next;
         }
@@ -450,6 +509,17 @@ namespace tinystl {
         insert(cend(), value);
     }
 
+    template<typename T, typename Alloc>
+    inline void List<T, Alloc>::pushBack(T &&value) {
+        insert(cend(), tinystl::move(value));
+    }
+
+    template<typename T, typename Alloc>
+    template<typename... Args>
+    inline void List<T, Alloc>::emplaceBack(Args&&... args) {
+        emplace(cend(), tinystl::forward<Args>(args)...);
+    }
+
     template<typename T, typename Alloc>
     inline void List<T, Alloc>::popBack() {
         erase(--cend());
@@ -460,6 +530,17 @@ namespace tinystl {
         insert(cbegin(), value);
     }
 
+    template<typename T, typename Alloc>
+    inline void List<T, Alloc>::pushFront(T &&value) {
+        insert(cbegin(), tinystl::move(value));
+    }
+
+    template<typename T, typename Alloc>
+    template<typename... Args>
+    inline void List<T, Alloc>::emplaceFront(Args&&... args) {
+        emplace(cbegin(), tinystl::forward<Args>(args)...);
+    }
+
     template<typename T, typename Alloc>
     inline void List<T, Alloc>::popFront() {
         erase(cbegin());
@@ -485,6 +566,7 @@ namespace tinystl {
     template<typename T, typename Alloc>
     inline void List<T, Alloc>::swap(_Self &other) {
         tinystl::swap(__node, other.__node);
+        _AllocHolder::_swapAlloc(other);
     }
 
     template<typename T, typename Alloc>
@@ -631,40 +713,54 @@ namespace tinystl {
         if(empty() || __node->next->next == __node) {
             return;
         }
-        List<T, Alloc> carry;
-        List<T, Alloc> counter[64];
+        // 临时链表与*this使用同一个分配器实例,按需构造
+        List<T, Alloc> carry(getAllocator());
+        alignas(_Self) char buffer[64 * sizeof(_Self)];
+        _Self *counter = reinterpret_cast<_Self *>(buffer);
         int fill = 0;
-        while(!empty()) {
-            carry.splice(carry.cbegin(), *this, this->cbegin());
-            int i = 0;
-            while(i < fill && !counter[i].empty()) {
-                counter[i].merge(carry);
-                carry.swap(counter[i++]);
+        try {
+            while(!empty()) {
+                carry.splice(carry.cbegin(), *this, this->cbegin());
+                int i = 0;
+                while(i < fill && !counter[i].empty()) {
+                    counter[i].merge(carry, pre);
+                    carry.swap(counter[i++]);
+                }
+                if(i == fill) {
+                    tinystl::construct(counter + fill, getAllocator());
+                    ++fill;
+                }
+                counter[i].swap(carry);
             }
-            counter[i].swap(carry);
-            if(i == fill) {
-                ++fill;
+            for(int i = 1; i < fill; ++i) {
+                counter[i].merge(counter[i - 1], pre);
             }
+        } catch(...) {
+            // 比较抛出异常时把所有结点放回*this,元素不会丢失但顺序不确定
+            splice(cend(), carry);
+            for(int i = 0; i < fill; ++i) {
+                splice(cend(), counter[i]);
+            }
+            tinystl::destroy(counter, counter + fill);
+            throw;
         }
-        for(int i = 1; i < fill; ++i) {
-            counter[i].merge(counter[i - 1]);
-        }
-        swap(counter[fill - 1]);
+        splice(cend(), counter[fill - 1]);
+        tinystl::destroy(counter, counter + fill);
     }
 
     template<typename T, typename Alloc>
     inline ListNode<T>* List<T, Alloc>::_createANode() {
-        return Allocator::allocate();
+        return Allocator::allocate(_AllocHolder::_getAlloc());
     }
 
     template<typename T, typename Alloc>
     inline void List<T, Alloc>::_releaseANode(ListNode<T> *ptr) {
-        Allocator::deallocate(ptr);
+        Allocator::deallocate(_AllocHolder::_getAlloc(), ptr);
     }
 
     template<typename T, typename Alloc>
     inline bool operator==(const List<T, Alloc> &lhs, const List<T, Alloc> &rhs) {
-        return lhs.size() == rhs.size() && equal(lhs.cbegin(), lhs.cend(),
+        return lhs.size() == rhs.size() && tinystl::equal(lhs.cbegin(), lhs.cend(),
                                                  rhs.cbegin());
     }
 
@@ -10,7 +10,7 @@
 namespace tinystl {
 
     template<typename Key, typename T, typename Compare=Less<Key>,
-             typename _Alloc=Alloc>
+             typename _Alloc=Alloc, bool orderStatistics=false>
     class Map {
     public:
         using KeyType = Key;
@@ -32,10 +32,10 @@ namespace tinystl {
             }
         };
         using _Container = RBTree<KeyType, ValueType, _KeyOfValue,
-                                  Compare, _Alloc>;
+                                  Compare, _Alloc, orderStatistics>;
 
     private:
-        using __Self = Map<Key, T, Compare, _Alloc>;
+        using __Self = Map<Key, T, Compare, _Alloc, orderStatistics>;
 
     public:
         using Iterator = typename _Container::Iterator;
@@ -44,13 +44,19 @@ namespace tinystl {
         using ConstReverseIterator = typename _Container::ConstReverseIterator;
 
         Map() = default;
-        Map(const Compare &compare): __container(compare) {}
+        Map(const Compare &compare, const _Alloc &alloc=_Alloc())
+            : __container(compare, alloc) {}
+        explicit Map(const _Alloc &alloc): __container(Compare(), alloc) {}
         template<typename InputIterator>
-        Map(InputIterator first, InputIterator second, const Compare &compare=Compare()) {
-            __container.insert(first, second);
+        Map(InputIterator first, InputIterator last, const Compare &compare=Compare(),
+            const _Alloc &alloc=_Alloc())
+            : __container(compare, alloc) {
+            __container.insertUnique(first, last);
         }
         Map(const __Self&) = default;
+        Map(__Self&&) = default;
         __Self& operator=(const __Self&) = default;
+        __Self& operator=(__Self&&) = default;
 
         MappedType& at(const KeyType &key) {
             Iterator it = __container.find(key);
@@ -65,11 +71,11 @@ namespace tinystl {
         }
 
         MappedType& operator[](const KeyType &key) {
-            Iterator it = find(key);
-            if(it == end()) {
-                it = insert(makePair<KeyType, MappedType>(key, MappedType())).first;
-            }
-            return it->second;
+            return tryEmplace(key).first->second;
+        }
+
+        MappedType& operator[](KeyType &&key) {
+            return tryEmplace(tinystl::move(key)).first->second;
         }
 
         Iterator begin() { return __container.begin(); }
@@ -88,20 +94,46 @@ namespace tinystl {
         bool empty() const { return __container.empty(); }
         SizeType size() const { return __container.size(); }
         SizeType maxSize() const { return __container.maxSize(); }
+        _Alloc getAllocator() const { return __container.getAllocator(); }
 
         void clear() { __container.clear(); }
 
         Pair<Iterator, bool> insert(const ValueType &value) {
             return __container.insertUnique(value);
         }
+        Pair<Iterator, bool> insert(ValueType &&value) {
+            return __container.insertUnique(tinystl::move(value));
+        }
         Iterator insert(Iterator hint, const ValueType &value) {
             return __container.insertUnique(hint, value);
         }
+        Iterator insert(Iterator hint, ValueType &&value) {
+            return __container.insertUnique(hint, tinystl::move(value));
+        }
         template<typename InputIterator>
         void insert(InputIterator first, InputIterator last) {
             __container.insertUnique(first, last);
         }
 
+        template<typename... Args>
+        Pair<Iterator, bool> emplace(Args&&... args) {
+            return __container.emplaceUnique(tinystl::forward<Args>(args)...);
+        }
+        template<typename... Args>
+        Iterator emplaceHint(Iterator hint, Args&&... args) {
+            return __container.emplaceHintUnique(hint, tinystl::forward<Args>(args)...);
+        }
+
+        // key不存在时才构造结点,MappedType直接由args在结点中构造
+        template<typename... Args>
+        Pair<Iterator, bool> tryEmplace(const KeyType &key, Args&&... args) {
+            return _tryEmplace(key, tinystl::forward<Args>(args)...);
+        }
+        template<typename... Args>
+        Pair<Iterator, bool> tryEmplace(KeyType &&key, Args&&... args) {
+            return _tryEmplace(tinystl::move(key), tinystl::forward<Args>(args)...);
+        }
+
         void erase(Iterator pos) { __container.erase(pos); }
         void erase(Iterator first, Iterator last) { __container.erase(first, last); }
 
@@ -109,7 +141,40 @@ namespace tinystl {
 
         void swap(__Self &other) {
             using tinystl::swap;
-            swap(__container, other.__container);
+            tinystl::swap(__container, other.__container);
+        }
+
+        // 键不小于key的元素移到right中,right原有的元素被清除
+        void split(const KeyType &key, __Self &right) {
+            __container.split(key, right.__container);
+        }
+        // right中的键都要大于*this中的键,否则抛出std::invalid_argument
+        // right中的元素移到*this中,时间为O(log n)
+        void join(__Self &right) {
+            if(!empty() && !right.empty() && !__container.keyCompare()(rbegin()->first, right.begin()->first)) {
+                throw std::invalid_argument("map join");
+            }
+            __container.join(right.__container);
+        }
+
+        // 以下需要orderStatistics为true,时间都为O(log n)
+        // 第k个(从0开始)元素,k不小于size()时返回end()
+        Iterator select(SizeType k) {
+            return __container.select(k);
+        }
+        ConstIterator select(SizeType k) const {
+            return __container.select(k);
+        }
+        // 键小于key的元素个数
+        SizeType rank(const KeyType &key) const {
+            return __container.rank(key);
+        }
+        // pos之前的元素个数,end()对应size()
+        SizeType index(ConstIterator pos) const {
+            return __container.index(pos);
+        }
+        DifferenceType distance(ConstIterator first, ConstIterator last) const {
+            return __container.distance(first, last);
         }
 
         SizeType count(const KeyType &key) const {
@@ -122,11 +187,11 @@ namespace tinystl {
             return __container.find(key);
         }
 
-        Iterator lowBound(const KeyType &key) {
-            return __container.lowBound(key);
+        Iterator lowerBound(const KeyType &key) {
+            return __container.lowerBound(key);
         }
-        ConstIterator lowBound(const KeyType &key) const {
-            return __container.lowBound(key);
+        ConstIterator lowerBound(const KeyType &key) const {
+            return __container.lowerBound(key);
         }
 
         Iterator upperBound(const KeyType &key) {
@@ -143,15 +208,76 @@ namespace tinystl {
             return __container.equalRange(key);
         }
 
-        template<typename Key1, typename T1, typename Compare1, typename _Alloc1>
-        friend bool operator==(const Map<Key1, T1, Compare1, _Alloc1> &lhs,
-                               const Map<Key1, T1, Compare1, _Alloc1> &rhs) ;
+        // Compare定义了IsTransparent时,可以用任何能和键比较的对象查找,不需要构造临时的键
+        template<typename K, typename C = Compare,
+                 typename = typename EnableIf<IsTransparent<C>::value>::Type>
+        SizeType count(const K &key) const {
+            return __container.count(key);
+        }
+        template<typename K, typename C = Compare,
+                 typename = typename EnableIf<IsTransparent<C>::value>::Type>
+        Iterator find(const K &key) {
+            return __container.find(key);
+        }
+        template<typename K, typename C = Compare,
+                 typename = typename EnableIf<IsTransparent<C>::value>::Type>
+        ConstIterator find(const K &key) const {
+            return __container.find(key);
+        }
+        template<typename K, typename C = Compare,
+                 typename = typename EnableIf<IsTransparent<C>::value>::Type>
+        Pair<Iterator, Iterator> equalRange(const K &key) {
+            return __container.equalRange(key);
+        }
+        template<typename K, typename C = Compare,
+                 typename = typename EnableIf<IsTransparent<C>::value>::Type>
+        Pair<ConstIterator, ConstIterator> equalRange(const K &key) const {
+            return __container.equalRange(key);
+        }
+        template<typename K, typename C = Compare,
+                 typename = typename EnableIf<IsTransparent<C>::value>::Type>
+        Iterator lowerBound(const K &key) {
+            return __container.lowerBound(key);
+        }
+        template<typename K, typename C = Compare,
+                 typename = typename EnableIf<IsTransparent<C>::value>::Type>
+        ConstIterator lowerBound(const K &key) const {
+            return __container.lowerBound(key);
+        }
+        template<typename K, typename C = Compare,
+                 typename = typename EnableIf<IsTransparent<C>::value>::Type>
+        Iterator upperBound(const K &key) {
+            return __container.upperBound(key);
+        }
+        template<typename K, typename C = Compare,
+                 typename = typename EnableIf<IsTransparent<C>::value>::Type>
+        ConstIterator upperBound(const K &key) const {
+            return __container.upperBound(key);
+        }
+
+        template<typename Key1, typename T1, typename Compare1,
+                 typename _Alloc1, bool orderStatistics1>
+        friend bool operator==(const Map<Key1, T1, Compare1, _Alloc1, orderStatistics1> &lhs,
+                               const Map<Key1, T1, Compare1, _Alloc1, orderStatistics1> &rhs) ;
 
-        template<typename Key1, typename T1, typename Compare1, typename _Alloc1>
-        friend bool operator<(const Map<Key1, T1, Compare1, _Alloc1> &lhs,
-                              const Map<Key1, T1, Compare1, _Alloc1> &rhs);
+        template<typename Key1, typename T1, typename Compare1,
+                 typename _Alloc1, bool orderStatistics1>
+        friend bool operator<(const Map<Key1, T1, Compare1, _Alloc1, orderStatistics1> &lhs,
+                              const Map<Key1, T1, Compare1, _Alloc1, orderStatistics1> &rhs);
 
     protected:
+        template<typename K, typename... Args>
+        Pair<Iterator, bool> _tryEmplace(K &&key, Args&&... args) {
+            Iterator it = __container.lowerBound(key);
+            if(it != end() && !__container.keyCompare()(key, it->first)) {
+                return Pair<Iterator, bool>(it, false);
+            }
+            return Pair<Iterator, bool>(__container.emplaceHintUnique(it, PiecewiseConstructTag(),
+                                                                      tinystl::forward<K>(key),
+                                                                      tinystl::forward<Args>(args)...),
+                                        true);
+        }
+
         void _rangeCheck(Iterator it) const {
             if(it == end()) {
                 throw std::out_of_range("map");
@@ -168,39 +294,39 @@ namespace tinystl {
         _Container __container;
     };
 
-    template<typename Key, typename T, typename Compare, typename _Alloc>
-    inline bool operator==(const Map<Key, T, Compare, _Alloc> &lhs,
-                           const Map<Key, T, Compare, _Alloc> &rhs) {
+    template<typename Key, typename T, typename Compare, typename _Alloc, bool orderStatistics>
+    inline bool operator==(const Map<Key, T, Compare, _Alloc, orderStatistics> &lhs,
+                           const Map<Key, T, Compare, _Alloc, orderStatistics> &rhs) {
         return lhs.__container == rhs.__container;
     }
 
-    template<typename Key, typename T, typename Compare, typename _Alloc>
-    inline bool operator!=(const Map<Key, T, Compare, _Alloc> &lhs,
-                           const Map<Key, T, Compare, _Alloc> &rhs) {
+    template<typename Key, typename T, typename Compare, typename _Alloc, bool orderStatistics>
+    inline bool operator!=(const Map<Key, T, Compare, _Alloc, orderStatistics> &lhs,
+                           const Map<Key, T, Compare, _Alloc, orderStatistics> &rhs) {
         return !(lhs == rhs);
     }
 
-    template<typename Key, typename T, typename Compare, typename _Alloc>
-    inline bool operator<(const Map<Key, T, Compare, _Alloc> &lhs,
-                          const Map<Key, T, Compare, _Alloc> &rhs) {
+    template<typename Key, typename T, typename Compare, typename _Alloc, bool orderStatistics>
+    inline bool operator<(const Map<Key, T, Compare, _Alloc, orderStatistics> &lhs,
+                          const Map<Key, T, Compare, _Alloc, orderStatistics> &rhs) {
         return lhs.__container < rhs.__container;
     }
 
-    template<typename Key, typename T, typename Compare, typename _Alloc>
-    inline bool operator>(const Map<Key, T, Compare, _Alloc> &lhs,
-                          const Map<Key, T, Compare, _Alloc> &rhs) {
+    template<typename Key, typename T, typename Compare, typename _Alloc, bool orderStatistics>
+    inline bool operator>(const Map<Key, T, Compare, _Alloc, orderStatistics> &lhs,
+                          const Map<Key, T, Compare, _Alloc, orderStatistics> &rhs) {
         return rhs < lhs;
     }
 
-    template<typename Key, typename T, typename Compare, typename _Alloc>
-    inline bool operator<=(const Map<Key, T, Compare, _Alloc> &lhs,
-                           const Map<Key, T, Compare, _Alloc> &rhs) {
+    template<typename Key, typename T, typename Compare, typename _Alloc, bool orderStatistics>
+    inline bool operator<=(const Map<Key, T, Compare, _Alloc, orderStatistics> &lhs,
+                           const Map<Key, T, Compare, _Alloc, orderStatistics> &rhs) {
         return !(lhs > rhs);
     }
 
-    template<typename Key, typename T, typename Compare, typename _Alloc>
-    inline bool operator>=(const Map<Key, T, Compare, _Alloc> &lhs,
-                           const Map<Key, T, Compare, _Alloc> &rhs) {
+    template<typename Key, typename T, typename Compare, typename _Alloc, bool orderStatistics>
+    inline bool operator>=(const Map<Key, T, Compare, _Alloc, orderStatistics> &lhs,
+                           const Map<Key, T, Compare, _Alloc, orderStatistics> &rhs) {
         return !(lhs < rhs);
     }
 
@@ -7,7 +7,8 @@
 
 namespace tinystl {
 
-    template<typename Key, typename Compare=Less<Key>, typename _Alloc=Alloc>
+    template<typename Key, typename Compare=Less<Key>, typename _Alloc=Alloc,
+             bool orderStatistics=false>
     class MultiSet {
     public:
         using KeyType = Key;
@@ -29,9 +30,9 @@ namespace tinystl {
             }
         };
         using _Container = RBTree<KeyType, ValueType, _KeyOfValue,
-                                  Compare, _Alloc>;
+                                  Compare, _Alloc, orderStatistics>;
     private:
-        using __Self = MultiSet<Key, Compare, _Alloc>;
+        using __Self = MultiSet<Key, Compare, _Alloc, orderStatistics>;
 
     public:
         using Iterator = typename _Container::Iterator;
@@ -40,14 +41,19 @@ namespace tinystl {
         using ConstReverseIterator = typename _Container::ConstReverseIterator;
 
         MultiSet() = default;
-        explicit MultiSet(const Compare &compare): __container(compare) {}
+        explicit MultiSet(const Compare &compare, const _Alloc &alloc=_Alloc())
+            : __container(compare, alloc) {}
+        explicit MultiSet(const _Alloc &alloc): __container(Compare(), alloc) {}
         template<typename InputIterator>
-        MultiSet(InputIterator first, InputIterator last,
-            const Compare &compare = Compare()): __container(compare) {
+        MultiSet(InputIterator first, InputIterator last, const Compare &compare=Compare(),
+                 const _Alloc &alloc=_Alloc())
+            : __container(compare, alloc) {
             __container.insertEqual(first, last);
         }
         MultiSet(const __Self&) = default;
+        MultiSet(__Self&&) = default;
         __Self& operator=(const __Self &other) = default;
+        __Self& operator=(__Self &&other) = default;
 
         Iterator begin() { return __container.begin(); }
         ConstIterator begin() const { return __container.begin(); }
@@ -65,18 +71,33 @@ namespace tinystl {
         bool empty() const { return __container.empty(); }
         SizeType size() const { return __container.size(); }
         SizeType maxSize() const { return __container.maxSize(); }
+        _Alloc getAllocator() const { return __container.getAllocator(); }
         void clear() { __container.clear(); }
 
         Iterator insert(const ValueType &value) {
             return __container.insertEqual(value); }
+        Iterator insert(ValueType &&value) {
+            return __container.insertEqual(tinystl::move(value)); }
         Iterator insert(ConstIterator pos, const ValueType &value) {
-            return __container.__insertEqual(pos.removeConst(), value);
+            return __container.insertEqual(pos.removeConst(), value);
+        }
+        Iterator insert(ConstIterator pos, ValueType &&value) {
+            return __container.insertEqual(pos.removeConst(), tinystl::move(value));
         }
         template<typename InputIterator>
         void insert(InputIterator first, InputIterator last) {
             __container.insertEqual(first, last);
         }
 
+        template<typename... Args>
+        Iterator emplace(Args&&... args) {
+            return __container.emplaceEqual(tinystl::forward<Args>(args)...);
+        }
+        template<typename... Args>
+        Iterator emplaceHint(ConstIterator pos, Args&&... args) {
+            return __container.emplaceHintEqual(pos.removeConst(), tinystl::forward<Args>(args)...);
+        }
+
         void erase(Iterator pos) { __container.erase(pos); }
         void erase(ConstIterator pos) { __container.erase(pos.removeConst()); }
         void erase(Iterator first, Iterator last) {
@@ -88,7 +109,36 @@ namespace tinystl {
 
         void swap(__Self &other) {
             using tinystl::swap;
-            swap(__container, other.__container);
+            tinystl::swap(__container, other.__container);
+        }
+
+        // 键不小于key的元素移到right中,right原有的元素被清除
+        void split(const KeyType &key, __Self &right) {
+            __container.split(key, right.__container);
+        }
+        // right中的键都要不小于*this中的键,right中的元素移到*this中,时间为O(log n)
+        void join(__Self &right) {
+            __container.join(right.__container);
+        }
+
+        // 以下需要orderStatistics为true,时间都为O(log n)
+        // 第k个(从0开始)元素,k不小于size()时返回end()
+        Iterator select(SizeType k) {
+            return __container.select(k);
+        }
+        ConstIterator select(SizeType k) const {
+            return __container.select(k);
+        }
+        // 键小于key的元素个数
+        SizeType rank(const KeyType &key) const {
+            return __container.rank(key);
+        }
+        // pos之前的元素个数,end()对应size()
+        SizeType index(ConstIterator pos) const {
+            return __container.index(pos);
+        }
+        DifferenceType distance(ConstIterator first, ConstIterator last) const {
+            return __container.distance(first, last);
         }
 
         SizeType count(const KeyType &key) const {
@@ -102,11 +152,11 @@ namespace tinystl {
             return __container.find(key);
         }
 
-        Iterator lowBound(const KeyType &key) {
-            return __container.lowBound(key);
+        Iterator lowerBound(const KeyType &key) {
+            return __container.lowerBound(key);
         }
-        ConstIterator lowBound(const KeyType &key) const {
-            return __container.lowBound(key);
+        ConstIterator lowerBound(const KeyType &key) const {
+            return __container.lowerBound(key);
         }
         Iterator upperBound(const KeyType &key) {
             return __container.upperBound(key);
@@ -122,50 +172,99 @@ namespace tinystl {
             return __container.equalRange(key);
         }
 
-        template<typename Key1, typename Compare1, typename _Alloc1>
-        friend bool operator==(const MultiSet<Key1, Compare1, _Alloc1> &lhs,
-                               const MultiSet<Key1, Compare1, _Alloc1> &rhs);
-        template<typename Key1, typename Compare1, typename _Alloc1>
-        friend bool operator<(const MultiSet<Key1, Compare1, _Alloc1> &lhs,
-                             const MultiSet<Key1, Compare1, _Alloc1> &rhs);
+        // Compare定义了IsTransparent时,可以用任何能和键比较的对象查找,不需要构造临时的键
+        template<typename K, typename C = Compare,
+                 typename = typename EnableIf<IsTransparent<C>::value>::Type>
+        SizeType count(const K &key) const {
+            return __container.count(key);
+        }
+        template<typename K, typename C = Compare,
+                 typename = typename EnableIf<IsTransparent<C>::value>::Type>
+        Iterator find(const K &key) {
+            return __container.find(key);
+        }
+        template<typename K, typename C = Compare,
+                 typename = typename EnableIf<IsTransparent<C>::value>::Type>
+        ConstIterator find(const K &key) const {
+            return __container.find(key);
+        }
+        template<typename K, typename C = Compare,
+                 typename = typename EnableIf<IsTransparent<C>::value>::Type>
+        Pair<Iterator, Iterator> equalRange(const K &key) {
+            return __container.equalRange(key);
+        }
+        template<typename K, typename C = Compare,
+                 typename = typename EnableIf<IsTransparent<C>::value>::Type>
+        Pair<ConstIterator, ConstIterator> equalRange(const K &key) const {
+            return __container.equalRange(key);
+        }
+        template<typename K, typename C = Compare,
+                 typename = typename EnableIf<IsTransparent<C>::value>::Type>
+        Iterator lowerBound(const K &key) {
+            return __container.lowerBound(key);
+        }
+        template<typename K, typename C = Compare,
+                 typename = typename EnableIf<IsTransparent<C>::value>::Type>
+        ConstIterator lowerBound(const K &key) const {
+            return __container.lowerBound(key);
+        }
+        template<typename K, typename C = Compare,
+                 typename = typename EnableIf<IsTransparent<C>::value>::Type>
+        Iterator upperBound(const K &key) {
+            return __container.upperBound(key);
+        }
+        template<typename K, typename C = Compare,
+                 typename = typename EnableIf<IsTransparent<C>::value>::Type>
+        ConstIterator upperBound(const K &key) const {
+            return __container.upperBound(key);
+        }
+
+        template<typename Key1, typename Compare1,
+                 typename _Alloc1, bool orderStatistics1>
+        friend bool operator==(const MultiSet<Key1, Compare1, _Alloc1, orderStatistics1> &lhs,
+                               const MultiSet<Key1, Compare1, _Alloc1, orderStatistics1> &rhs);
+        template<typename Key1, typename Compare1,
+                 typename _Alloc1, bool orderStatistics1>
+        friend bool operator<(const MultiSet<Key1, Compare1, _Alloc1, orderStatistics1> &lhs,
+                             const MultiSet<Key1, Compare1, _Alloc1, orderStatistics1> &rhs);
 
     private:
         _Container __container;
     };
 
-    template<typename Key, typename Compare, typename _Alloc>
-    inline bool operator==(const MultiSet<Key, Compare, _Alloc> &lhs,
-                           const MultiSet<Key, Compare, _Alloc> &rhs) {
+    template<typename Key, typename Compare, typename _Alloc, bool orderStatistics>
+    inline bool operator==(const MultiSet<Key, Compare, _Alloc, orderStatistics> &lhs,
+                           const MultiSet<Key, Compare, _Alloc, orderStatistics> &rhs) {
         return lhs.__container == rhs.__container;
     }
 
-    template<typename Key, typename Compare, typename _Alloc>
-    inline bool operator!=(const MultiSet<Key, Compare, _Alloc> &lhs,
-                           const MultiSet<Key, Compare, _Alloc> &rhs) {
+    template<typename Key, typename Compare, typename _Alloc, bool orderStatistics>
+    inline bool operator!=(const MultiSet<Key, Compare, _Alloc, orderStatistics> &lhs,
+                           const MultiSet<Key, Compare, _Alloc, orderStatistics> &rhs) {
         return !(lhs == rhs);
     }
 
-    template<typename Key, typename Compare, typename _Alloc>
-    inline bool operator<(const MultiSet<Key, Compare, _Alloc> &lhs,
-                          const MultiSet<Key, Compare, _Alloc> &rhs) {
+    template<typename Key, typename Compare, typename _Alloc, bool orderStatistics>
+    inline bool operator<(const MultiSet<Key, Compare, _Alloc, orderStatistics> &lhs,
+                          const MultiSet<Key, Compare, _Alloc, orderStatistics> &rhs) {
         return lhs.__container < rhs.__container;
     }
 
-    template<typename Key, typename Compare, typename _Alloc>
-    inline bool operator>(const MultiSet<Key, Compare, _Alloc> &lhs,
-                          const MultiSet<Key, Compare, _Alloc> &rhs) {
+    template<typename Key, typename Compare, typename _Alloc, bool orderStatistics>
+    inline bool operator>(const MultiSet<Key, Compare, _Alloc, orderStatistics> &lhs,
+                          const MultiSet<Key, Compare, _Alloc, orderStatistics> &rhs) {
         return rhs < lhs;
     }
 
-    template<typename Key, typename Compare, typename _Alloc>
-    inline bool operator<=(const MultiSet<Key, Compare, _Alloc> &lhs,
-                           const MultiSet<Key, Compare, _Alloc> &rhs) {
+    template<typename Key, typename Compare, typename _Alloc, bool orderStatistics>
+    inline bool operator<=(const MultiSet<Key, Compare, _Alloc, orderStatistics> &lhs,
+                           const MultiSet<Key, Compare, _Alloc, orderStatistics> &rhs) {
         return !(rhs < lhs);
     }
 
-    template<typename Key, typename Compare, typename _Alloc>
-    inline bool operator>=(const MultiSet<Key, Compare, _Alloc> &lhs,
-                           const MultiSet<Key, Compare, _Alloc> &rhs) {
+    template<typename Key, typename Compare, typename _Alloc, bool orderStatistics>
+    inline bool operator>=(const MultiSet<Key, Compare, _Alloc, orderStatistics> &lhs,
+                           const MultiSet<Key, Compare, _Alloc, orderStatistics> &rhs) {
         return !(lhs < rhs);
     }
 
@@ -0,0 +1,228 @@
+#ifndef OBJECTPOOL_H
+#define OBJECTPOOL_H
+
+#include <new>
+#include <cstddef>
+#include <mutex>
+#include "alloc.h"
+
+namespace tinystl {
+    const std::size_t CACHE_LINE_SIZE = 64;
+
+    constexpr std::size_t __alignUp(std::size_t n, std::size_t align) {
+        return (n + align - 1) & ~(align - 1);
+    }
+
+    // 只分配T大小对象的slab分配器
+    // 对象紧密排列在按cache line对齐的slab中,释放的对象按后进先出复用,
+    // slab只在ObjectPool析构时释放
+    // slotAlign为每个对象的对齐,取CACHE_LINE_SIZE时每个对象独占cache line
+    template<typename T, std::size_t slotAlign = alignof(T), std::size_t slabSize = 64 * 1024>
+    class ObjectPool {
+    public:
+        ObjectPool(): freeList(nullptr), slabList(nullptr), cursor(nullptr), end(nullptr),
+                      slabTotal(0), freeTotal(0) {}
+
+        ObjectPool(const ObjectPool &) = delete;
+        ObjectPool& operator=(const ObjectPool &) = delete;
+
+        ~ObjectPool() {
+            while(slabList) {
+                Slab *next = slabList->next;
+                MallocChunkSource::deallocate(slabList, slabList->size);
+                slabList = next;
+            }
+        }
+
+        T* allocate() {
+            if(freeList) {
+                Slot *slot = freeList;
+                freeList = slot->next;
+                --freeTotal;
+                return reinterpret_cast<T *>(slot);
+            }
+            if(cursor == end) {
+                newSlab();
+            }
+            T *result = reinterpret_cast<T *>(cursor);
+            cursor += SLOT_SIZE;
+            return result;
+        }
+
+        void deallocate(T *ptr) {
+            if(!ptr) {
+                return;
+            }
+            Slot *slot = reinterpret_cast<Slot *>(ptr);
+            slot->next = freeList;
+            freeList = slot;
+            ++freeTotal;
+        }
+
+        std::size_t slabCount() const {
+            return slabTotal;
+        }
+
+        // freeList上的对象个数,不包括slab中还没有切分的部分
+        std::size_t freeCount() const {
+            return freeTotal;
+        }
+
+        static std::size_t slotSize() {
+            return SLOT_SIZE;
+        }
+
+    private:
+        union Slot {
+            Slot *next;
+            char data[sizeof(T)];
+        };
+
+        struct Slab {
+            Slab *next;
+            std::size_t size;
+        };
+
+        static const std::size_t ALIGN = slotAlign > alignof(Slot)? slotAlign: alignof(Slot);
+        static const std::size_t SLOT_SIZE = __alignUp(sizeof(Slot), ALIGN);
+        static const std::size_t SLAB_ALIGN = ALIGN > CACHE_LINE_SIZE? ALIGN: CACHE_LINE_SIZE;
+        static const std::size_t HEADER_SIZE = __alignUp(sizeof(Slab), SLAB_ALIGN);
+        // 每个slab至少容纳8个对象
+        static const std::size_t SLAB_BYTES = slabSize > HEADER_SIZE + SLOT_SIZE * 8?
+                                              slabSize: HEADER_SIZE + SLOT_SIZE * 8;
+
+        static_assert((slotAlign & (slotAlign - 1)) == 0, "slotAlign must be a power of 2");
+
+        void newSlab() {
+            std::size_t size = SLAB_BYTES;
+            Slab *slab = static_cast<Slab *>(MallocChunkSource::allocate(size, SLAB_ALIGN));
+            if(!slab) {
+                throw std::bad_alloc();
+            }
+            slab->next = slabList;
+            slab->size = size;
+            slabList = slab;
+            ++slabTotal;
+            // slab按需切分,没有用到的部分不会被访问
+            cursor = reinterpret_cast<char *>(slab) + HEADER_SIZE;
+            end = cursor + (size - HEADER_SIZE) / SLOT_SIZE * SLOT_SIZE;
+        }
+
+        Slot *freeList;
+        Slab *slabList;
+        char *cursor;
+        char *end;
+        std::size_t slabTotal;
+        std::size_t freeTotal;
+    };
+
+    // 作为容器的_Alloc参数时,容器的节点(通过SimpleAlloc<T, PoolAlloc>::allocate()分配的单个对象)
+    // 来自每种类型共享的ObjectPool,其它按字节或数组的分配(例如HashTable的桶)交给Fallback
+    // threads为true时共享的ObjectPool由互斥锁保护
+    template<int inst, bool threads = false, typename Fallback = Alloc>
+    class PoolAlloc {
+    public:
+        static void* allocate(std::size_t n) {
+            return Fallback::allocate(n);
+        }
+
+        static void deallocate(void *ptr, std::size_t n) {
+            Fallback::deallocate(ptr, n);
+        }
+
+        static void* reallocate(void *ptr, std::size_t oldSize, std::size_t newSize) {
+            return Fallback::reallocate(ptr, oldSize, newSize);
+        }
+
+        template<typename T>
+        static T* allocateObject() {
+            Shared<T> &shared = getShared<T>();
+            Lock lock(shared.mutex);
+            return shared.pool.allocate();
+        }
+
+        template<typename T>
+        static void deallocateObject(T *ptr) {
+            Shared<T> &shared = getShared<T>();
+            Lock lock(shared.mutex);
+            shared.pool.deallocate(ptr);
+        }
+
+        template<typename T>
+        static ObjectPool<T>& pool() {
+            return getShared<T>().pool;
+        }
+
+    private:
+        template<typename T>
+        struct Shared {
+            ObjectPool<T> pool;
+            std::mutex mutex;
+        };
+
+        struct Lock {
+            explicit Lock(std::mutex &mutex): mutex(mutex) {
+                if(threads) {
+                    mutex.lock();
+                }
+            }
+            ~Lock() {
+                if(threads) {
+                    mutex.unlock();
+                }
+            }
+            std::mutex &mutex;
+        };
+
+        // 有意不析构,静态存储期的容器在程序退出时仍然可以释放节点
+        template<typename T>
+        static Shared<T>& getShared() {
+            static Shared<T> *shared = new Shared<T>;
+            return *shared;
+        }
+    };
+
+    template<typename T, int inst, bool threads, typename Fallback>
+    class SimpleAlloc<T, PoolAlloc<inst, threads, Fallback>> {
+    private:
+        using Alloc = PoolAlloc<inst, threads, Fallback>;
+        using ArrayAlloc = SimpleAlloc<T, Fallback>;
+
+    public:
+        static T* allocate() {
+            return Alloc::template allocateObject<T>();
+        }
+
+        static T* allocate(std::size_t n) {
+            return ArrayAlloc::allocate(n);
+        }
+
+        static void deallocate(T *ptr) {
+            Alloc::template deallocateObject<T>(ptr);
+        }
+
+        static void deallocate(T *ptr, std::size_t n) {
+            ArrayAlloc::deallocate(ptr, n);
+        }
+
+        static T* allocate(Alloc &) {
+            return allocate();
+        }
+
+        static T* allocate(Alloc &, std::size_t n) {
+            return allocate(n);
+        }
+
+        static void deallocate(Alloc &, T *ptr) {
+            deallocate(ptr);
+        }
+
+        static void deallocate(Alloc &, T *ptr, std::size_t n) {
+            deallocate(ptr, n);
+        }
+    };
+
+    using PoolAllocator = PoolAlloc<0>;
+}
+
+#endif
@@ -5,6 +5,9 @@
 
 namespace tinystl {
 
+    // 用于原地构造Pair,first由第一个参数构造,second由剩余的参数构造
+    struct PiecewiseConstructTag {};
+
     template<typename T1, typename T2>
     struct Pair {
         using FirstType = T1;
@@ -13,11 +16,17 @@ namespace tinystl {
         Pair(): first(T1()), second(T2()) {}
         Pair(const T1 &_first, const T2 &_second)
             : first(_first), second(_second) {}
+        template<typename U1, typename U2>
+        Pair(U1 &&_first, U2 &&_second)
+            : first(tinystl::forward<U1>(_first)), second(tinystl::forward<U2>(_second)) {}
+        template<typename U1, typename... Args>
+        Pair(PiecewiseConstructTag, U1 &&_first, Args&&... args)
+            : first(tinystl::forward<U1>(_first)), second(tinystl::forward<Args>(args)...) {}
 
         void swap(Pair<FirstType, SecondType> &other) {
             using tinystl::swap;
-            swap(first, other->first);
-            swap(second, other->second);
+            tinystl::swap(first, other.first);
+            tinystl::swap(second, other.second);
         }
 
         FirstType first;
@@ -19,15 +19,20 @@ namespace tinystl {
         explicit PriorityQueue(const Compare &compare=Compare(),
                                const Container &container=Container())
             : __container(container), __comp(compare) {}
+        PriorityQueue(const Compare &compare, Container &&container)
+            : __container(tinystl::move(container)), __comp(compare) {}
 
         Reference top() { return __container.front(); }
         ConstReference top() const { return __container.front(); }
         bool empty() const { return __container.empty(); }
         SizeType size() const { return __container.size(); }
         void push(const T &value);
+        void push(T &&value);
+        template<typename... Args>
+        void emplace(Args&&... args);
         void pop();
         void swap(PriorityQueue<T, Container, Compare> &other) {
-            swap(__container, other.__container);
+            tinystl::swap(__container, other.__container);
         }
 
         template<typename T1, typename Container1, typename Compare1>
@@ -60,6 +65,19 @@ namespace tinystl {
         pushHeap(__container.begin(), __container.end(), __comp);
     }
 
+    template<typename T, typename Container, typename Compare>
+    inline void PriorityQueue<T, Container, Compare>::push(T &&value) {
+        __container.pushBack(tinystl::move(value));
+        pushHeap(__container.begin(), __container.end(), __comp);
+    }
+
+    template<typename T, typename Container, typename Compare>
+    template<typename... Args>
+    inline void PriorityQueue<T, Container, Compare>::emplace(Args&&... args) {
+        __container.emplaceBack(tinystl::forward<Args>(args)...);
+        pushHeap(__container.begin(), __container.end(), __comp);
+    }
+
     template<typename T, typename Container, typename Compare>
     inline void PriorityQueue<T, Container, Compare>::pop() {
         popHeap(__container.begin(), __container.end(), __comp);
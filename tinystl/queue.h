@@ -19,7 +19,11 @@ namespace tinystl {
 
     public:
         explicit Queue(const Container &cont=Container()): __container(cont) {};
+        explicit Queue(Container &&cont): __container(tinystl::move(cont)) {};
         Queue(const _Self &) = default;
+        Queue(_Self &&) = default;
+        _Self& operator=(const _Self &) = default;
+        _Self& operator=(_Self &&) = default;
         Reference front() { return __container.front(); };
         ConstReference front() const { return __container.front(); };
         Reference back() { return __container.back(); };
@@ -27,6 +31,9 @@ namespace tinystl {
         bool empty() const { return __container.empty(); };
         SizeType size() const { return __container.size(); };
         void push(const T &value) { __container.pushBack(value); };
+        void push(T &&value) { __container.pushBack(tinystl::move(value)); };
+        template<typename... Args>
+        void emplace(Args&&... args) { __container.emplaceBack(tinystl::forward<Args>(args)...); }
         void pop() { __container.popFront(); };
         void swap(_Self &other) { using tinystl::swap; swap(__container, other.__container); };
 
@@ -1,6 +1,8 @@
 #ifndef RBTREE_H
 #define RBTREE_H
 
+#include <cstddef>
+#include <stdexcept>
 #include "construct.h"
 #include "pair.h"
 #include "alloc.h"
@@ -47,7 +49,62 @@ namespace tinystl {
         T data;
     };
 
-    void __leftRotate(__RBTreeNodeBase* &root, __RBTreeNodeBase *x) {
+    // 额外记录子树中的结点个数,用于顺序统计
+    // size放在data之后,迭代器仍然可以把结点当作__RBTreeNode<T>访问
+    template<typename T>
+    struct __RBTreeSizedNode: public __RBTreeNode<T> {
+        std::size_t size;
+    };
+
+    // 结点的附加信息在树的结构改变时如何维护
+    // update(x)在x的孩子改变后重新计算x,add(x, root, delta)修改从x到root路径上的每个结点
+    struct __RBTreeNoAugment {
+        static std::size_t size(const __RBTreeNodeBase *) { return 0; }
+        static void update(__RBTreeNodeBase *) {}
+        static void copy(__RBTreeNodeBase *, const __RBTreeNodeBase *) {}
+        static void add(__RBTreeNodeBase *, __RBTreeNodeBase *, std::ptrdiff_t) {}
+        static bool verify(const __RBTreeNodeBase *) { return true; }
+    };
+
+    template<typename Node>
+    struct __RBTreeSizeAugment {
+        static std::size_t size(const __RBTreeNodeBase *x) {
+            return x? static_cast<const Node *>(x)->size: 0;
+        }
+        static void update(__RBTreeNodeBase *x) {
+            static_cast<Node *>(x)->size = size(x->left) + size(x->right) + 1;
+        }
+        static void copy(__RBTreeNodeBase *x, const __RBTreeNodeBase *other) {
+            static_cast<Node *>(x)->size = size(other);
+        }
+        static void add(__RBTreeNodeBase *x, __RBTreeNodeBase *root, std::ptrdiff_t delta) {
+            while(x) {
+                static_cast<Node *>(x)->size += delta;
+                if(x == root) {
+                    break;
+                }
+                x = x->parent;
+            }
+        }
+        static bool verify(const __RBTreeNodeBase *x) {
+            return size(x) == size(x->left) + size(x->right) + 1;
+        }
+    };
+
+    template<typename T, bool orderStatistics>
+    struct __RBTreeNodeTraits {
+        using Node = __RBTreeNode<T>;
+        using Augment = __RBTreeNoAugment;
+    };
+
+    template<typename T>
+    struct __RBTreeNodeTraits<T, true> {
+        using Node = __RBTreeSizedNode<T>;
+        using Augment = __RBTreeSizeAugment<Node>;
+    };
+
+    template<typename Augment>
+    inline void __leftRotate(__RBTreeNodeBase* &root, __RBTreeNodeBase *x) {
         // 没有右孩子就没有什么好转的
         if(!x->right) {
             return;
@@ -67,10 +124,12 @@ namespace tinystl {
         }
         xRightSon->left = x;
         x->parent = xRightSon;
-
+        Augment::update(x);
+        Augment::update(xRightSon);
     }
 
-    void __rightRotate(__RBTreeNodeBase* &root, __RBTreeNodeBase *x) {
+    template<typename Augment>
+    inline void __rightRotate(__RBTreeNodeBase* &root, __RBTreeNodeBase *x) {
         // 没有左孩子不能转
         if(!x->left) {
             return;
@@ -90,9 +149,13 @@ namespace tinystl {
         }
         xLeftSon->right = x;
         x->parent = xLeftSon;
+        Augment::update(x);
+        Augment::update(xLeftSon);
     }
 
-    void __rebalanceTreeAfterInsert(__RBTreeNodeBase* &root,
+    // 返回根是否由红变黑,此时整棵树的黑高加一
+    template<typename Augment>
+    inline bool __rebalanceTreeAfterInsert(__RBTreeNodeBase* &root,
                                     __RBTreeNodeBase *x) {
         // x表示已经插入到以root为根的树中的节点
         x->color = red;
@@ -107,11 +170,11 @@ namespace tinystl {
                 } else {
                     if(x == x->parent->right) {
                         x = x->parent;
-                        __leftRotate(root, x);
+                        __leftRotate<Augment>(root, x);
                     }
                     x->parent->color = black;
                     x->parent->parent->color = red;
-                    __rightRotate(root, x->parent->parent);
+                    __rightRotate<Augment>(root, x->parent->parent);
                 }
             } else {
                 __RBTreeNodeBase *y = x->parent->parent->left;
@@ -123,18 +186,21 @@ namespace tinystl {
                 } else {
                     if(x == x->parent->left) {
                         x = x->parent;
-                        __rightRotate(root, x);
+                        __rightRotate<Augment>(root, x);
                     }
                     x->parent->parent->color = red;
                     x->parent->color = black;
-                    __leftRotate(root, x->parent->parent);
+                    __leftRotate<Augment>(root, x->parent->parent);
                 }
             }
         }
+        const bool grown = root->color == red;
         root->color = black;
+        return grown;
     }
 
-    void __rebalanceTreeAfterDelete(__RBTreeNodeBase* &root,
+    template<typename Augment>
+    inline void __rebalanceTreeAfterDelete(__RBTreeNodeBase* &root,
                                     __RBTreeNodeBase *x,
                                     __RBTreeNodeBase *xParent) {
         // x表示用来替代已删除那个节点的点
@@ -147,7 +213,7 @@ namespace tinystl {
                 if(w->color == red) {
                     w->color = black;
                     xParent->color = red;
-                    __leftRotate(root, xParent);
+                    __leftRotate<Augment>(root, xParent);
                     w = xParent->right;
                 }
                 if((w->left == nullptr || w->left->color == black) &&
@@ -161,13 +227,13 @@ namespace tinystl {
                             w->left->color = black;
                         }
                         w->color = red;
-                        __rightRotate(root, w);
+                        __rightRotate<Augment>(root, w);
                         w = xParent->right;
                     }
                     w->color = xParent->color;
                     xParent->color = black;
                     w->right->color = black;
-                    __leftRotate(root, xParent);
+                    __leftRotate<Augment>(root, xParent);
                     x = root;
                 }
             } else {
@@ -175,7 +241,7 @@ namespace tinystl {
                 if(w->color == red) {
                     w->color = black;
                     xParent->color = red;
-                    __rightRotate(root, xParent);
+                    __rightRotate<Augment>(root, xParent);
                     w = xParent->left;
                 }
                 if((w->left == nullptr || w->left->color == black) &&
@@ -189,13 +255,13 @@ namespace tinystl {
                             w->right->color = black;
                         }
                         w->color = red;
-                        __leftRotate(root, w);
+                        __leftRotate<Augment>(root, w);
                         w = xParent->left;
                     }
                     w->color = xParent->color;
                     xParent->color = black;
                     w->left->color = black;
-                    __rightRotate(root, xParent);
+                    __rightRotate<Augment>(root, xParent);
                     x = root;
                 }
             }
@@ -205,7 +271,8 @@ namespace tinystl {
         }
     }
 
-    __RBTreeNodeBase* __deleteANode(__RBTreeNodeBase* &root,
+    template<typename Augment>
+    inline __RBTreeNodeBase* __deleteANode(__RBTreeNodeBase* &root,
                                     __RBTreeNodeBase *z,
                                     __RBTreeNodeBase* &leftMost,
                                     __RBTreeNodeBase* &rightMost) {
@@ -228,6 +295,8 @@ namespace tinystl {
                 x = y->right;
             }
         }
+        // y是从树中实际摘下的位置,它和它的祖先都少了一个结点
+        Augment::add(y, root, -1);
         // y != z说明要删除的节点z有两个孩子，应使用z的后继y来顶替z。
         if(y != z) {
             y->left = z->left;
@@ -251,6 +320,7 @@ namespace tinystl {
             } else {
                 z->parent->right = y;
             }
+            Augment::update(y);
             tinystl::swap(y->color, z->color);
             y = z;
         } else {
@@ -282,11 +352,75 @@ namespace tinystl {
             }
         }
         if(y->color == black) {
-            __rebalanceTreeAfterDelete(root, x, xParent);
+            __rebalanceTreeAfterDelete<Augment>(root, x, xParent);
         }
         return y;
     }
 
+    // 用pivot把两棵树连成一棵,left中的结点都排在pivot之前,right中的都排在pivot之后
+    // left和right的根都是黑色(或为空),黑高分别为leftHeight和rightHeight。
+    // 沿较高的树靠近另一棵树的一侧向下找到黑高相同的黑结点,用红色的pivot代替它,
+    // 它和较矮的树成为pivot的孩子,再按插入的方式调整,时间为O(|leftHeight - rightHeight| + 1)
+    // 返回的根的parent为nullptr,height为合并后的黑高
+    template<typename Augment>
+    inline __RBTreeNodeBase* __joinTree(__RBTreeNodeBase *left, std::size_t leftHeight,
+                                        __RBTreeNodeBase *pivot,
+                                        __RBTreeNodeBase *right, std::size_t rightHeight,
+                                        std::size_t &height) {
+        if(leftHeight == rightHeight) {
+            pivot->parent = nullptr;
+            pivot->left = left;
+            pivot->right = right;
+            pivot->color = black;
+            if(left) {
+                left->parent = pivot;
+            }
+            if(right) {
+                right->parent = pivot;
+            }
+            Augment::update(pivot);
+            height = leftHeight + 1;
+            return pivot;
+        }
+        const bool leftTaller = leftHeight > rightHeight;
+        __RBTreeNodeBase *root = leftTaller? left: right;
+        const std::size_t target = leftTaller? rightHeight: leftHeight;
+        std::size_t h = leftTaller? leftHeight: rightHeight;
+        __RBTreeNodeBase *parent = nullptr;
+        __RBTreeNodeBase *x = root;
+        // 红结点的孩子和它的黑高相同
+        while(x && (x->color == red || h > target)) {
+            if(x->color == black) {
+                --h;
+            }
+            parent = x;
+            x = leftTaller? x->right: x->left;
+        }
+        if(leftTaller) {
+            pivot->left = x;
+            pivot->right = right;
+            parent->right = pivot;
+        } else {
+            pivot->left = left;
+            pivot->right = x;
+            parent->left = pivot;
+        }
+        pivot->parent = parent;
+        if(pivot->left) {
+            pivot->left->parent = pivot;
+        }
+        if(pivot->right) {
+            pivot->right->parent = pivot;
+        }
+        Augment::update(pivot);
+        Augment::add(parent, root, static_cast<std::ptrdiff_t>(Augment::size(pivot)) -
+                                   static_cast<std::ptrdiff_t>(Augment::size(x)));
+        root->parent = nullptr;
+        height = (leftTaller? leftHeight: rightHeight) +
+            (__rebalanceTreeAfterInsert<Augment>(root, pivot)? 1: 0);
+        return root;
+    }
+
     // ----------------------------------------------------------------------
     // IteratorBase
     struct __RBTreeIteratorBase {
@@ -354,6 +488,7 @@ namespace tinystl {
         __RBTreeIteratorTemplate(const Iterator &other) {
             _node = other._node;
         }
+        _Self& operator=(const _Self &other) = default;
 
         Reference operator*() const {
             return static_cast<_LinkType>(_node)->data;
@@ -395,29 +530,35 @@ namespace tinystl {
     }
 
     // RBTreeBase
-    template<typename T, typename _Alloc>
-    struct __RBTreeBase {
-        __RBTreeBase(): _header(nullptr) {
+    // Node为实际分配的结点类型,可以是__RBTreeNode<T>的派生类
+    template<typename T, typename _Alloc, typename Node = __RBTreeNode<T>>
+    struct __RBTreeBase: protected __AllocHolder<_Alloc> {
+        explicit __RBTreeBase(const _Alloc &alloc=_Alloc()): __AllocHolder<_Alloc>(alloc),
+                                                            _header(nullptr) {
             _header = _createANode();
         }
         ~__RBTreeBase() {
             _releaseANode(_header);
         }
     protected:
-        using Allocator = SimpleAlloc<__RBTreeNode<T>, _Alloc>;
+        using Allocator = SimpleAlloc<Node, _Alloc>;
+        using __AllocHolder<_Alloc>::_getAlloc;
         __RBTreeNode<T>* _createANode() {
-            return Allocator::allocate();
+            return Allocator::allocate(_getAlloc());
         }
         void _releaseANode(__RBTreeNode<T> *ptr) {
-            Allocator::deallocate(ptr);
+            Allocator::deallocate(_getAlloc(), static_cast<Node *>(ptr));
         }
 
         __RBTreeNode<T> *_header;
     };
 
+    // orderStatistics为true时每个结点记录子树大小,支持O(log n)的select、rank和distance,
+    // 每个结点多占用一个std::size_t
     template<typename Key, typename Value, typename KeyOfValue,
-             typename Compare, typename _Alloc=Alloc>
-    class RBTree: protected __RBTreeBase<Value, _Alloc> {
+             typename Compare, typename _Alloc=Alloc, bool orderStatistics=false>
+    class RBTree: protected __RBTreeBase<Value, _Alloc,
+                                         typename __RBTreeNodeTraits<Value, orderStatistics>::Node> {
     public:
         using KeyType = Key;
         using ValueType = Value;
@@ -432,19 +573,22 @@ namespace tinystl {
         using _BasePtr = __RBTreeNodeBase*;
         using _RBTreeNode = __RBTreeNode<ValueType>;
         using ColorType = __RBTreeNodeColorType;
+        using _Augment = typename __RBTreeNodeTraits<ValueType, orderStatistics>::Augment;
     private:
-        using __Base = __RBTreeBase<ValueType, _Alloc>;
+        using __Base = __RBTreeBase<ValueType, _Alloc,
+                                    typename __RBTreeNodeTraits<ValueType, orderStatistics>::Node>;
 
     protected:
-        using __Base::_createANode;
         using __Base::_releaseANode;
         using __Base::_header;
 
     protected:
-        _LinkType _createANode(const ValueType &value) {
-            _LinkType ptr = _createANode();
+        // 直接在结点中构造值,隐藏了__Base中只分配内存的_createANode
+        template<typename... Args>
+        _LinkType _createANode(Args&&... args) {
+            _LinkType ptr = __Base::_createANode();
             try {
-                construct(&ptr->data, value);
+                tinystl::construct(&ptr->data, tinystl::forward<Args>(args)...);
             } catch(...) {
                 _releaseANode(ptr);
                 throw;
@@ -458,11 +602,12 @@ namespace tinystl {
             ptr->parent = other->parent;
             ptr->left = other->left;
             ptr->right = other->right;
+            _Augment::copy(ptr, other);
             return ptr;
         }
 
-        _LinkType _destroyANode(_LinkType ptr) {
-            destroy(&ptr->data);
+        void _destroyANode(_LinkType ptr) {
+            tinystl::destroy(&ptr->data);
             _releaseANode(ptr);
         }
 
@@ -505,17 +650,46 @@ namespace tinystl {
         using ConstReverseIterator = ReverseIteratorTemplate<ConstIterator>;
 
     private:
-        using __Self = RBTree<Key, Value, KeyOfValue, Compare, _Alloc>;
-        Iterator __insert(_BasePtr x, _BasePtr y, const ValueType &v);
+        using __Self = RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>;
+        using __InsertPos = Pair<_BasePtr, _BasePtr>;
+        Iterator __insert(_BasePtr x, _BasePtr p, _LinkType newNode);
+        __InsertPos __getInsertUniquePos(const KeyType &key);
+        __InsertPos __getInsertEqualPos(const KeyType &key);
+        __InsertPos __getInsertHintUniquePos(Iterator pos, const KeyType &key);
+        __InsertPos __getInsertHintEqualPos(Iterator pos, const KeyType &key);
+        template<typename Arg>
+        Pair<Iterator, bool> __insertUnique(Arg &&arg);
+        template<typename Arg>
+        Iterator __insertEqual(Arg &&arg);
+        template<typename Arg>
+        Iterator __insertUnique(Iterator pos, Arg &&arg);
+        template<typename Arg>
+        Iterator __insertEqual(Iterator pos, Arg &&arg);
+        Pair<Iterator, bool> __insertUniqueNode(__InsertPos pos, _LinkType newNode);
         _LinkType __copy(_LinkType src, _LinkType top);
         void __erase(_LinkType root);
+        template<typename InputIterator>
+        _LinkType __buildFromSorted(InputIterator &first, InputIterator last, bool unique);
+        void __linkBalanced(_LinkType list, SizeType n);
+        void __joinNode(_LinkType pivot, __Self &right);
+        void __split(_BasePtr root, SizeType height, const KeyType &key,
+                     _BasePtr &left, SizeType &leftHeight,
+                     _BasePtr &right, SizeType &rightHeight) const;
+        void __resetRoot(_BasePtr root, _BasePtr leftMost, _BasePtr rightMost);
+        static SizeType __blackHeight(_BasePtr root);
+        static void __detachSubtree(_BasePtr root, SizeType &height);
+        SizeType __splitCount(SizeType total, const __Self &right, TrueType) const;
+        SizeType __splitCount(SizeType total, const __Self &right, FalseType) const;
+        static _LinkType __buildBalanced(_LinkType &list, SizeType n,
+                                         SizeType depth, SizeType redDepth);
 
     public:
         RBTree(): _nodeCount(0), _key_comparer() { __emptyInitialize(); }
-        RBTree(const Compare &compare): _nodeCount(0), _key_comparer() {
+        RBTree(const Compare &compare, const _Alloc &alloc=_Alloc()): __Base(alloc), _nodeCount(0),
+                                                                       _key_comparer(compare) {
             __emptyInitialize();
         }
-        RBTree(const __Self &other): _nodeCount(0),
+        RBTree(const __Self &other): __Base(other.getAllocator()), _nodeCount(0),
                                      _key_comparer(other._key_comparer) {
             if(other.empty()) {
                 __emptyInitialize();
@@ -527,6 +701,12 @@ namespace tinystl {
                 _nodeCount = other._nodeCount;
             }
         }
+        // 新分配的头结点留给other
+        RBTree(__Self &&other): __Base(other.getAllocator()), _nodeCount(0),
+                                _key_comparer(other._key_comparer) {
+            __emptyInitialize();
+            swap(other);
+        }
         ~RBTree() { clear(); }
 
         __Self& operator=(const __Self &other) {
@@ -549,6 +729,14 @@ namespace tinystl {
             return *this;
         }
 
+        __Self& operator=(__Self &&other) {
+            if(this != &other) {
+                clear();
+                swap(other);
+            }
+            return *this;
+        }
+
     private:
         void __emptyInitialize() {
             _root() = nullptr;
@@ -559,6 +747,7 @@ namespace tinystl {
 
     public:
         Compare keyCompare() const { return _key_comparer; }
+        _Alloc getAllocator() const { return __Base::_getAlloc(); }
         Iterator begin() { return Iterator(_leftMost()); }
         ConstIterator begin() const { return ConstIterator(_leftMost()); }
         ConstIterator cbegin() const { return ConstIterator(_leftMost()); }
@@ -577,16 +766,61 @@ namespace tinystl {
 
         void swap(__Self &other) {
             using tinystl::swap;
-            swap(_header, other._header);
-            swap(_nodeCount, other._nodeCount);
-            swap(_key_comparer, other._key_comparer);
+            tinystl::swap(_header, other._header);
+            tinystl::swap(_nodeCount, other._nodeCount);
+            tinystl::swap(_key_comparer, other._key_comparer);
+            __Base::_swapAlloc(other);
         }
 
     public:
-        Pair<Iterator, bool> insertUnique(const ValueType &value);
-        Iterator insertEqual(const ValueType &value);
-        Iterator insertUnique(Iterator pos, const ValueType &value);
-        Iterator insertEqual(Iterator pos, const ValueType &value);
+        Pair<Iterator, bool> insertUnique(const ValueType &value) {
+            return __insertUnique(value);
+        }
+        Pair<Iterator, bool> insertUnique(ValueType &&value) {
+            return __insertUnique(tinystl::move(value));
+        }
+        Iterator insertEqual(const ValueType &value) {
+            return __insertEqual(value);
+        }
+        Iterator insertEqual(ValueType &&value) {
+            return __insertEqual(tinystl::move(value));
+        }
+        Iterator insertUnique(Iterator pos, const ValueType &value) {
+            return __insertUnique(pos, value);
+        }
+        Iterator insertUnique(Iterator pos, ValueType &&value) {
+            return __insertUnique(pos, tinystl::move(value));
+        }
+        Iterator insertEqual(Iterator pos, const ValueType &value) {
+            return __insertEqual(pos, value);
+        }
+        Iterator insertEqual(Iterator pos, ValueType &&value) {
+            return __insertEqual(pos, tinystl::move(value));
+        }
+
+        // 先在结点中构造值再查找插入位置,键已经存在时销毁新结点
+        template<typename... Args>
+        Pair<Iterator, bool> emplaceUnique(Args&&... args) {
+            _LinkType newNode = _createANode(tinystl::forward<Args>(args)...);
+            return __insertUniqueNode(__getInsertUniquePos(_key(newNode)), newNode);
+        }
+        template<typename... Args>
+        Iterator emplaceEqual(Args&&... args) {
+            _LinkType newNode = _createANode(tinystl::forward<Args>(args)...);
+            __InsertPos res = __getInsertEqualPos(_key(newNode));
+            return __insert(res.first, res.second, newNode);
+        }
+        template<typename... Args>
+        Iterator emplaceHintUnique(Iterator pos, Args&&... args) {
+            _LinkType newNode = _createANode(tinystl::forward<Args>(args)...);
+            return __insertUniqueNode(__getInsertHintUniquePos(pos, _key(newNode)), newNode).first;
+        }
+        template<typename... Args>
+        Iterator emplaceHintEqual(Iterator pos, Args&&... args) {
+            _LinkType newNode = _createANode(tinystl::forward<Args>(args)...);
+            __InsertPos res = __getInsertHintEqualPos(pos, _key(newNode));
+            return __insert(res.first, res.second, newNode);
+        }
         template<typename InputIterator>
         void insertUnique(InputIterator first, InputIterator last);
         template<typename InputIterator>
@@ -598,6 +832,38 @@ namespace tinystl {
         void erase(const KeyType *first, const KeyType *last);
         void clear();
 
+        // 键不小于key的元素移到right中,right原有的元素被清除,两棵树的分配器必须相同
+        // 调整树的结构需要O(log n),orderStatistics为false时统计两边的元素个数
+        // 需要O(较少一边的元素个数)
+        void split(const KeyType &key, __Self &right);
+        // *this中的键都不大于pivot的键,right中的都不小于pivot的键,否则抛出std::invalid_argument
+        // pivot和right中的元素移到*this中,right被清空,时间为O(log n)
+        void join(const ValueType &pivot, __Self &right) {
+            __checkJoin(KeyOfValue()(pivot), right);
+            __joinNode(_createANode(pivot), right);
+        }
+        void join(ValueType &&pivot, __Self &right) {
+            __checkJoin(KeyOfValue()(pivot), right);
+            __joinNode(_createANode(tinystl::move(pivot)), right);
+        }
+        // 没有pivot时用right中最小的结点作为pivot
+        void join(__Self &right);
+
+        // 以下需要orderStatistics为true,时间都为O(log n)
+        // 中序中第k个(从0开始)元素,k不小于size()时返回end()
+        Iterator select(SizeType k) {
+            return static_cast<const __Self* const>(this)->select(k).removeConst();
+        }
+        ConstIterator select(SizeType k) const;
+        // 键小于key的元素个数
+        SizeType rank(const KeyType &key) const;
+        // it在中序中的位置,end()的位置为size()
+        SizeType index(ConstIterator it) const;
+        DifferenceType distance(ConstIterator first, ConstIterator last) const {
+            return static_cast<DifferenceType>(index(last)) -
+                static_cast<DifferenceType>(index(first));
+        }
+
         Iterator find(const KeyType &key);
         ConstIterator find(const KeyType &key) const;
         SizeType count(const KeyType &key) const;
@@ -608,15 +874,64 @@ namespace tinystl {
         Pair<Iterator, Iterator> equalRange(const KeyType &key);
         Pair<ConstIterator, ConstIterator> equalRange(const KeyType &key) const;
 
+        // Compare定义了IsTransparent时,可以用任何能和键比较的对象查找,不需要构造临时的键
+        template<typename K, typename C = Compare,
+                 typename = typename EnableIf<IsTransparent<C>::value>::Type>
+        Iterator find(const K &key) { return _find(key).removeConst(); }
+        template<typename K, typename C = Compare,
+                 typename = typename EnableIf<IsTransparent<C>::value>::Type>
+        ConstIterator find(const K &key) const { return _find(key); }
+        template<typename K, typename C = Compare,
+                 typename = typename EnableIf<IsTransparent<C>::value>::Type>
+        SizeType count(const K &key) const {
+            return tinystl::distance(_lowerBound(key), _upperBound(key));
+        }
+        template<typename K, typename C = Compare,
+                 typename = typename EnableIf<IsTransparent<C>::value>::Type>
+        Iterator lowerBound(const K &key) { return _lowerBound(key).removeConst(); }
+        template<typename K, typename C = Compare,
+                 typename = typename EnableIf<IsTransparent<C>::value>::Type>
+        ConstIterator lowerBound(const K &key) const { return _lowerBound(key); }
+        template<typename K, typename C = Compare,
+                 typename = typename EnableIf<IsTransparent<C>::value>::Type>
+        Iterator upperBound(const K &key) { return _upperBound(key).removeConst(); }
+        template<typename K, typename C = Compare,
+                 typename = typename EnableIf<IsTransparent<C>::value>::Type>
+        ConstIterator upperBound(const K &key) const { return _upperBound(key); }
+        template<typename K, typename C = Compare,
+                 typename = typename EnableIf<IsTransparent<C>::value>::Type>
+        Pair<Iterator, Iterator> equalRange(const K &key) {
+            return makePair(lowerBound(key), upperBound(key));
+        }
+        template<typename K, typename C = Compare,
+                 typename = typename EnableIf<IsTransparent<C>::value>::Type>
+        Pair<ConstIterator, ConstIterator> equalRange(const K &key) const {
+            return makePair(_lowerBound(key), _upperBound(key));
+        }
+
         bool rbVerify() const;
     protected:
+        void __checkJoin(const KeyType &key, const __Self &right) const {
+            if((!empty() && _key_comparer(key, _key(_rightMost()))) ||
+               (!right.empty() && _key_comparer(_key(right._leftMost()), key))) {
+                throw std::invalid_argument("rbtree join");
+            }
+        }
+
+        template<typename K>
+        ConstIterator _find(const K &key) const;
+        template<typename K>
+        ConstIterator _lowerBound(const K &key) const;
+        template<typename K>
+        ConstIterator _upperBound(const K &key) const;
+
         SizeType _blackCount(_BasePtr leaf, _BasePtr root) const;
     };
 
     template<typename Key, typename Value, typename KeyOfValue,
-             typename Compare, typename _Alloc>
-    typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::_LinkType
-    RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::__copy(_LinkType src,
+             typename Compare, typename _Alloc, bool orderStatistics>
+    typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::_LinkType
+    RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::__copy(_LinkType src,
                                                             _LinkType dest) {
         // 递归的将src拷到dest下
         _LinkType top = _cloneANode(src);
@@ -645,8 +960,8 @@ namespace tinystl {
     }
 
     template<typename Key, typename Value, typename KeyOfValue,
-             typename Compare, typename _Alloc>
-    void RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::__erase(_LinkType root) {
+             typename Compare, typename _Alloc, bool orderStatistics>
+    void RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::__erase(_LinkType root) {
         while(root) {
             __erase(_right(root));
             _LinkType leftSon = _left(root);
@@ -656,14 +971,11 @@ namespace tinystl {
     }
 
     template<typename Key, typename Value, typename KeyOfValue,
-             typename Compare, typename _Alloc>
-    typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::Iterator
-    RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::__insert(_BasePtr x,
-                                                              _BasePtr p,
-                                                              const ValueType &value) {
-        _LinkType newNode = _createANode(value);
+             typename Compare, typename _Alloc, bool orderStatistics>
+    typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::Iterator
+    RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::__insert(_BasePtr x, _BasePtr p, _LinkType newNode) {
         if(p == _header || x ||
-           _key_comparer(KeyOfValue()(value), _key(p))) {
+           _key_comparer(_key(newNode), _key(p))) {
             _left(p) = newNode;
             if(p == _header) {
                 _root() = newNode;
@@ -681,154 +993,527 @@ namespace tinystl {
         _left(newNode) = nullptr;
         _right(newNode) = nullptr;
         _color(newNode) = red;
-        __rebalanceTreeAfterInsert(_header->parent, newNode);
+        _Augment::update(newNode);
+        if(p != _header) {
+            _Augment::add(p, _root(), 1);
+        }
+        __rebalanceTreeAfterInsert<_Augment>(_header->parent, newNode);
         ++_nodeCount;
         return Iterator(newNode);
     }
 
+    // 返回的second是新结点的父结点,first不为空时新结点一定作为左孩子
+    // second为空表示key已经存在,first指向相等的结点
     template<typename Key, typename Value, typename KeyOfValue,
-             typename Compare, typename _Alloc>
-    Pair<typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::Iterator, bool>
-    RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::insertUnique(const ValueType &value) {
+             typename Compare, typename _Alloc, bool orderStatistics>
+    typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::__InsertPos
+    RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::__getInsertUniquePos(const KeyType &key) {
         _LinkType cur = _header;
         _LinkType next = _root();
-        if(next == nullptr) {
-            return Pair<Iterator, bool>(__insert(next, cur, value), true);
-        }
-
+        bool less = true;
         while(next) {
             cur = next;
-            next = _key_comparer(KeyOfValue()(value), _key(next))?
-                _left(next): _right(next);
+            less = _key_comparer(key, _key(next));
+            next = less? _left(next): _right(next);
         }
-        // 为了判断value是否和某个值相等
+        // 为了判断key是否和某个值相等
         // 如果大于当前值，则不可能有相等的
         // 如果小于当前值，也有可能等于前一个
         Iterator prev = Iterator(cur);
-        if(_key_comparer(KeyOfValue()(value), _key(cur))) {
+        if(less) {
             if(prev == begin()) {
-                return Pair<Iterator, bool>(__insert(next, cur, value), true);
+                return __InsertPos(nullptr, cur);
             }
             --prev;
         }
-        if(_key_comparer(_key(prev._node), KeyOfValue()(value))) {
-            return Pair<Iterator, bool>(__insert(next, cur, value), true);
+        if(_key_comparer(_key(prev._node), key)) {
+            return __InsertPos(nullptr, cur);
         }
         // 其他情况表示已经存在
-        return Pair<Iterator, bool>(prev, false);
+        return __InsertPos(prev._node, nullptr);
+    }
+
+    template<typename Key, typename Value, typename KeyOfValue,
+             typename Compare, typename _Alloc, bool orderStatistics>
+    typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::__InsertPos
+    RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::__getInsertEqualPos(const KeyType &key) {
+        _LinkType cur = _header;
+        _LinkType next = _root();
+        while(next) {
+            cur = next;
+            next = _key_comparer(key, _key(next))? _left(cur): _right(cur);
+        }
+        return __InsertPos(nullptr, cur);
     }
 
     template<typename Key, typename Value, typename KeyOfValue,
-             typename Compare, typename _Alloc>
-    typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::Iterator
-    RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::insertUnique(Iterator pos, const ValueType &value) {
+             typename Compare, typename _Alloc, bool orderStatistics>
+    typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::__InsertPos
+    RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::__getInsertHintUniquePos(Iterator pos, const KeyType &key) {
         if(pos == begin()) {
-            if(size() > 0 && _key_comparer(KeyOfValue()(value), _key(pos._node))) {
-                return __insert(pos._node, pos._node, value);
-            } else {
-                return insertUnique(value).first;
+            if(size() > 0 && _key_comparer(key, _key(pos._node))) {
+                return __InsertPos(pos._node, pos._node);
             }
         } else if(pos == end()) {
-            if(size() > 0 && _key_comparer(_key(_rightMost()), KeyOfValue(value))) {
-                return __insert(nullptr, _rightMost(), value);
-            } else {
-                return insertUnique(value).first;
+            if(size() > 0 && _key_comparer(_key(_rightMost()), key)) {
+                return __InsertPos(nullptr, _rightMost());
             }
         } else {
             Iterator prev = pos;
             --prev;
-            if(_key_comparer(_key(prev._node), KeyOfValue()(value)) &&
-               _key_comparer(KeyOfValue()(value), _key(pos._node))) {
+            if(_key_comparer(_key(prev._node), key) &&
+               _key_comparer(key, _key(pos._node))) {
                 if(_right(prev._node) == nullptr) {
-                    return __insert(nullptr, prev._node, value);
+                    return __InsertPos(nullptr, prev._node);
                 } else if(_left(pos._node) == nullptr) {
-                    return __insert(pos._node, pos._node, value);
+                    return __InsertPos(pos._node, pos._node);
                 }
             }
         }
-        return insertUnique(value).first;
-    }
-
-    template<typename Key, typename Value, typename KeyOfValue,
-             typename Compare, typename _Alloc>
-    typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::Iterator
-    RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::insertEqual(const ValueType &value) {
-        _LinkType cur = _header;
-        _LinkType next = _root();
-        while(next) {
-            cur = next;
-            next = _key_comparer(KeyOfValue()(value), _key(next))?
-                _left(cur): _right(cur);
-        }
-        return __insert(next, cur, value);
+        return __getInsertUniquePos(key);
     }
 
     template<typename Key, typename Value, typename KeyOfValue,
-             typename Compare, typename _Alloc>
-    typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::Iterator
-    RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::insertEqual(Iterator pos,
-                                                                 const ValueType &value) {
+             typename Compare, typename _Alloc, bool orderStatistics>
+    typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::__InsertPos
+    RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::__getInsertHintEqualPos(Iterator pos, const KeyType &key) {
         if(pos == begin()) {
-            if(size() > 0 && !_key_comparer(_key(pos._node), KeyOfValue()(value))) {
-                return __insert(pos._node, pos._node, value);
-            } else {
-                return insertEqual(value);
+            if(size() > 0 && !_key_comparer(_key(pos._node), key)) {
+                return __InsertPos(pos._node, pos._node);
             }
         } else if(pos == end()) {
-            if(size() > 0 && !_key_comparer(KeyOfValue()(value), _key(_right()))) {
-                return __insert(nullptr, pos._node, value);
-            } else {
-                return insertEqual(value);
+            if(size() > 0 && !_key_comparer(key, _key(_rightMost()))) {
+                return __InsertPos(nullptr, _rightMost());
             }
         } else {
             Iterator prev = pos;
             --prev;
-            if(!_key_comparer(KeyOfValue()(value), _key(prev._node)) &&
-               !_key_comparer(_key(pos._node), KeyOfValue()(value))) {
+            if(!_key_comparer(key, _key(prev._node)) &&
+               !_key_comparer(_key(pos._node), key)) {
                 if(_right(prev._node) == nullptr) {
-                    return __insert(nullptr, prev._node, value);
+                    return __InsertPos(nullptr, prev._node);
                 } else if(_left(pos._node) == nullptr) {
-                    return __insert(pos._node, pos._node, value);
+                    return __InsertPos(pos._node, pos._node);
                 }
             }
         }
-        return insertEqual(value);
+        return __getInsertEqualPos(key);
+    }
+
+    template<typename Key, typename Value, typename KeyOfValue,
+             typename Compare, typename _Alloc, bool orderStatistics>
+    Pair<typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::Iterator, bool>
+    RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::__insertUniqueNode(__InsertPos pos, _LinkType newNode) {
+        if(pos.second) {
+            return Pair<Iterator, bool>(__insert(pos.first, pos.second, newNode), true);
+        }
+        _destroyANode(newNode);
+        return Pair<Iterator, bool>(Iterator(static_cast<_LinkType>(pos.first)), false);
+    }
+
+    template<typename Key, typename Value, typename KeyOfValue,
+             typename Compare, typename _Alloc, bool orderStatistics>
+    template<typename Arg>
+    Pair<typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::Iterator, bool>
+    RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::__insertUnique(Arg &&value) {
+        __InsertPos pos = __getInsertUniquePos(KeyOfValue()(value));
+        if(pos.second) {
+            return Pair<Iterator, bool>(__insert(pos.first, pos.second,
+                                                 _createANode(tinystl::forward<Arg>(value))), true);
+        }
+        return Pair<Iterator, bool>(Iterator(static_cast<_LinkType>(pos.first)), false);
+    }
+
+    template<typename Key, typename Value, typename KeyOfValue,
+             typename Compare, typename _Alloc, bool orderStatistics>
+    template<typename Arg>
+    typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::Iterator
+    RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::__insertUnique(Iterator pos, Arg &&value) {
+        __InsertPos res = __getInsertHintUniquePos(pos, KeyOfValue()(value));
+        if(res.second) {
+            return __insert(res.first, res.second, _createANode(tinystl::forward<Arg>(value)));
+        }
+        return Iterator(static_cast<_LinkType>(res.first));
+    }
+
+    template<typename Key, typename Value, typename KeyOfValue,
+             typename Compare, typename _Alloc, bool orderStatistics>
+    template<typename Arg>
+    typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::Iterator
+    RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::__insertEqual(Arg &&value) {
+        __InsertPos pos = __getInsertEqualPos(KeyOfValue()(value));
+        return __insert(pos.first, pos.second, _createANode(tinystl::forward<Arg>(value)));
+    }
+
+    template<typename Key, typename Value, typename KeyOfValue,
+             typename Compare, typename _Alloc, bool orderStatistics>
+    template<typename Arg>
+    typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::Iterator
+    RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::__insertEqual(Iterator pos, Arg &&value) {
+        __InsertPos res = __getInsertHintEqualPos(pos, KeyOfValue()(value));
+        return __insert(res.first, res.second, _createANode(tinystl::forward<Arg>(value)));
     }
 
     template<typename Key, typename Value, typename KeyOfValue,
-             typename Compare, typename _Alloc>
+             typename Compare, typename _Alloc, bool orderStatistics>
     template<typename InputIterator>
-    inline void RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::
+    inline void RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::
     insertUnique(InputIterator first, InputIterator last) {
+        if(empty()) {
+            _LinkType node = __buildFromSorted(first, last, true);
+            if(!node) {
+                return;
+            }
+            __insertUniqueNode(__getInsertUniquePos(_key(node)), node);
+        }
+        // 以end()为提示,有序的部分每次插入只需要比较一次
         while(first != last) {
-            insertUnique(*first++);
+            insertUnique(end(), *first++);
         }
     }
 
     template<typename Key, typename Value, typename KeyOfValue,
-             typename Compare, typename _Alloc>
+             typename Compare, typename _Alloc, bool orderStatistics>
     template<typename InputIterator>
-    inline void RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::
+    inline void RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::
     insertEqual(InputIterator first, InputIterator last) {
+        if(empty()) {
+            _LinkType node = __buildFromSorted(first, last, false);
+            if(!node) {
+                return;
+            }
+            __InsertPos res = __getInsertEqualPos(_key(node));
+            __insert(res.first, res.second, node);
+        }
         while(first != last) {
-            insertEqual(*first++);
+            insertEqual(end(), *first++);
         }
     }
 
+    // 只用于空树。逐个构造结点并用right串成链表,输入有序时在线性时间内建成平衡树,
+    // unique为true时跳过相等的元素。遇到比前一个元素小的元素时,先把已有的结点建成树,
+    // 返回这个元素的结点,由调用者插入,first指向下一个元素
     template<typename Key, typename Value, typename KeyOfValue,
-             typename Compare, typename _Alloc>
-    inline void RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::
+             typename Compare, typename _Alloc, bool orderStatistics>
+    template<typename InputIterator>
+    typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::_LinkType
+    RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::
+    __buildFromSorted(InputIterator &first, InputIterator last, bool unique) {
+        _LinkType head = nullptr;
+        _LinkType tail = nullptr;
+        SizeType n = 0;
+        _LinkType unsorted = nullptr;
+        try {
+            while(first != last) {
+                _LinkType node = _createANode(*first++);
+                if(tail) {
+                    if(_key_comparer(_key(node), _key(tail))) {
+                        unsorted = node;
+                        break;
+                    }
+                    if(unique && !_key_comparer(_key(tail), _key(node))) {
+                        _destroyANode(node);
+                        continue;
+                    }
+                    _right(tail) = node;
+                } else {
+                    head = node;
+                }
+                _right(node) = nullptr;
+                tail = node;
+                ++n;
+            }
+        } catch(...) {
+            while(head) {
+                _LinkType next = _right(head);
+                _destroyANode(head);
+                head = next;
+            }
+            throw;
+        }
+        __linkBalanced(head, n);
+        return unsorted;
+    }
+
+    // 把有序链表建成完全平衡的树,成为空树的全部结点
+    template<typename Key, typename Value, typename KeyOfValue,
+             typename Compare, typename _Alloc, bool orderStatistics>
+    void RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::__linkBalanced(_LinkType list, SizeType n) {
+        if(n == 0) {
+            return;
+        }
+        // 前redDepth层是满的,只有第redDepth层(从0开始)的结点染成红色,
+        // 每条路径上都有redDepth个黑结点
+        SizeType redDepth = 0;
+        while((static_cast<SizeType>(2) << redDepth) - 1 <= n) {
+            ++redDepth;
+        }
+        _LinkType first = list;
+        _LinkType root = __buildBalanced(list, n, 0, redDepth);
+        root->parent = _header;
+        _root() = root;
+        _leftMost() = first;
+        _rightMost() = _maximum(root);
+        _nodeCount = n;
+    }
+
+    template<typename Key, typename Value, typename KeyOfValue,
+             typename Compare, typename _Alloc, bool orderStatistics>
+    void RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::join(__Self &right) {
+        if(right.empty()) {
+            return;
+        }
+        if(!empty() && _key_comparer(_key(right._leftMost()), _key(_rightMost()))) {
+            throw std::invalid_argument("rbtree join");
+        }
+        _BasePtr pivot = __deleteANode<_Augment>(right._header->parent, right._leftMost(),
+                                                 right._header->left, right._header->right);
+        --right._nodeCount;
+        if(right.empty()) {
+            right.__emptyInitialize();
+        }
+        __joinNode(static_cast<_LinkType>(pivot), right);
+    }
+
+    template<typename Key, typename Value, typename KeyOfValue,
+             typename Compare, typename _Alloc, bool orderStatistics>
+    void RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::__joinNode(_LinkType pivot, __Self &right) {
+        _BasePtr leftRoot = _root();
+        _BasePtr rightRoot = right._root();
+        const SizeType leftHeight = __blackHeight(leftRoot);
+        const SizeType rightHeight = __blackHeight(rightRoot);
+        if(leftRoot) {
+            leftRoot->parent = nullptr;
+        }
+        if(rightRoot) {
+            rightRoot->parent = nullptr;
+        }
+        SizeType height;
+        _BasePtr root = __joinTree<_Augment>(leftRoot, leftHeight, pivot, rightRoot, rightHeight, height);
+        __resetRoot(root, leftRoot? _leftMost(): pivot, rightRoot? right._rightMost(): pivot);
+        _nodeCount += right._nodeCount + 1;
+        right.__emptyInitialize();
+        right._nodeCount = 0;
+    }
+
+    template<typename Key, typename Value, typename KeyOfValue,
+             typename Compare, typename _Alloc, bool orderStatistics>
+    void RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::split(const KeyType &key, __Self &right) {
+        right.clear();
+        if(empty()) {
+            return;
+        }
+        const SizeType total = _nodeCount;
+        _BasePtr leftMost = _leftMost();
+        _BasePtr rightMost = _rightMost();
+        _BasePtr root = _root();
+        root->parent = nullptr;
+        _BasePtr leftRoot, rightRoot;
+        SizeType leftHeight, rightHeight;
+        __split(root, __blackHeight(root), key, leftRoot, leftHeight, rightRoot, rightHeight);
+        __resetRoot(leftRoot, leftMost, __RBTreeNodeBase::getMaxNode(leftRoot));
+        right.__resetRoot(rightRoot, __RBTreeNodeBase::getMinNode(rightRoot), rightMost);
+
+        _nodeCount = __splitCount(total, right, typename BoolType<orderStatistics>::Type());
+        right._nodeCount = total - _nodeCount;
+    }
+
+    // split之后*this中的元素个数
+    template<typename Key, typename Value, typename KeyOfValue,
+             typename Compare, typename _Alloc, bool orderStatistics>
+    inline typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::SizeType
+    RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::
+    __splitCount(SizeType, const __Self &, TrueType) const {
+        return _Augment::size(_root());
+    }
+
+    // 从两头同时遍历,较少的一边遍历完时停止
+    template<typename Key, typename Value, typename KeyOfValue,
+             typename Compare, typename _Alloc, bool orderStatistics>
+    typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::SizeType
+    RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::
+    __splitCount(SizeType total, const __Self &right, FalseType) const {
+        ConstIterator first = cbegin();
+        ConstIterator last = right.cend();
+        SizeType n = 0;
+        while(first != cend() && last != right.cbegin()) {
+            ++first;
+            --last;
+            ++n;
+        }
+        return first == cend()? n: total - n;
+    }
+
+    template<typename Key, typename Value, typename KeyOfValue,
+             typename Compare, typename _Alloc, bool orderStatistics>
+    typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::ConstIterator
+    RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::select(SizeType k) const {
+        static_assert(orderStatistics, "select requires orderStatistics");
+        _BasePtr cur = _root();
+        while(cur) {
+            const SizeType leftSize = _Augment::size(cur->left);
+            if(k < leftSize) {
+                cur = cur->left;
+            } else if(k == leftSize) {
+                return ConstIterator(static_cast<_LinkType>(cur));
+            } else {
+                k -= leftSize + 1;
+                cur = cur->right;
+            }
+        }
+        return cend();
+    }
+
+    template<typename Key, typename Value, typename KeyOfValue,
+             typename Compare, typename _Alloc, bool orderStatistics>
+    typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::SizeType
+    RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::rank(const KeyType &key) const {
+        static_assert(orderStatistics, "rank requires orderStatistics");
+        SizeType result = 0;
+        _LinkType cur = _root();
+        while(cur) {
+            if(!_key_comparer(_key(cur), key)) {
+                cur = _left(cur);
+            } else {
+                result += _Augment::size(cur->left) + 1;
+                cur = _right(cur);
+            }
+        }
+        return result;
+    }
+
+    // 从it向上走到根,每次从右子树上来时加上父结点和它的左子树
+    template<typename Key, typename Value, typename KeyOfValue,
+             typename Compare, typename _Alloc, bool orderStatistics>
+    typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::SizeType
+    RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::index(ConstIterator it) const {
+        static_assert(orderStatistics, "index requires orderStatistics");
+        if(it == cend()) {
+            return size();
+        }
+        _BasePtr cur = it._node;
+        SizeType result = _Augment::size(cur->left);
+        while(cur != _root()) {
+            if(cur == cur->parent->right) {
+                result += _Augment::size(cur->parent->left) + 1;
+            }
+            cur = cur->parent;
+        }
+        return result;
+    }
+
+    // 把以root为根、黑高为height的树按key分成两棵,left中的键都小于key,right中的都不小于key
+    // 每一层把一个结点和它的一棵子树接到结果上,各次__joinTree的黑高差加起来为O(log n)
+    template<typename Key, typename Value, typename KeyOfValue,
+             typename Compare, typename _Alloc, bool orderStatistics>
+    void RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::
+    __split(_BasePtr root, SizeType height, const KeyType &key,
+            _BasePtr &left, SizeType &leftHeight, _BasePtr &right, SizeType &rightHeight) const {
+        if(!root) {
+            left = right = nullptr;
+            leftHeight = rightHeight = 0;
+            return;
+        }
+        _BasePtr leftChild = root->left;
+        _BasePtr rightChild = root->right;
+        SizeType leftChildHeight = height - (root->color == black? 1: 0);
+        SizeType rightChildHeight = leftChildHeight;
+        __detachSubtree(leftChild, leftChildHeight);
+        __detachSubtree(rightChild, rightChildHeight);
+        _BasePtr rest;
+        SizeType restHeight;
+        if(_key_comparer(_key(root), key)) {
+            __split(rightChild, rightChildHeight, key, rest, restHeight, right, rightHeight);
+            left = __joinTree<_Augment>(leftChild, leftChildHeight, root, rest, restHeight, leftHeight);
+        } else {
+            __split(leftChild, leftChildHeight, key, left, leftHeight, rest, restHeight);
+            right = __joinTree<_Augment>(rest, restHeight, root, rightChild, rightChildHeight, rightHeight);
+        }
+    }
+
+    template<typename Key, typename Value, typename KeyOfValue,
+             typename Compare, typename _Alloc, bool orderStatistics>
+    void RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::
+    __resetRoot(_BasePtr root, _BasePtr leftMost, _BasePtr rightMost) {
+        if(!root) {
+            __emptyInitialize();
+            return;
+        }
+        root->parent = _header;
+        _header->parent = root;
+        _header->left = leftMost;
+        _header->right = rightMost;
+    }
+
+    template<typename Key, typename Value, typename KeyOfValue,
+             typename Compare, typename _Alloc, bool orderStatistics>
+    typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::SizeType
+    RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::__blackHeight(_BasePtr root) {
+        SizeType height = 0;
+        for(; root; root = root->left) {
+            if(root->color == black) {
+                ++height;
+            }
+        }
+        return height;
+    }
+
+    // 子树作为一棵独立的树时根必须是黑色
+    template<typename Key, typename Value, typename KeyOfValue,
+             typename Compare, typename _Alloc, bool orderStatistics>
+    void RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::
+    __detachSubtree(_BasePtr root, SizeType &height) {
+        if(!root) {
+            return;
+        }
+        root->parent = nullptr;
+        if(root->color == red) {
+            root->color = black;
+            ++height;
+        }
+    }
+
+    // 中序消耗链表中的n个结点,中间的结点作为根,左右子树的大小最多相差1
+    template<typename Key, typename Value, typename KeyOfValue,
+             typename Compare, typename _Alloc, bool orderStatistics>
+    typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::_LinkType
+    RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::
+    __buildBalanced(_LinkType &list, SizeType n, SizeType depth, SizeType redDepth) {
+        if(n == 0) {
+            return nullptr;
+        }
+        const SizeType leftCount = (n - 1) / 2;
+        _LinkType left = __buildBalanced(list, leftCount, depth + 1, redDepth);
+        _LinkType root = list;
+        list = _right(list);
+        _left(root) = left;
+        if(left) {
+            left->parent = root;
+        }
+        _color(root) = depth == redDepth? red: black;
+        _LinkType right = __buildBalanced(list, n - 1 - leftCount, depth + 1, redDepth);
+        _right(root) = right;
+        if(right) {
+            right->parent = root;
+        }
+        _Augment::update(root);
+        return root;
+    }
+
+    template<typename Key, typename Value, typename KeyOfValue,
+             typename Compare, typename _Alloc, bool orderStatistics>
+    inline void RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::
     erase(Iterator pos) {
-        _BasePtr ptr = __deleteANode(_header->parent, pos._node,
-                                     _header->left, _header->right);
+        _BasePtr ptr = __deleteANode<_Augment>(_header->parent, pos._node,
+                                               _header->left, _header->right);
         _destroyANode(static_cast<_LinkType>(ptr));
         --_nodeCount;
     }
 
     template<typename Key, typename Value, typename KeyOfValue,
-             typename Compare, typename _Alloc>
-    inline typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::SizeType
-    RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::
+             typename Compare, typename _Alloc, bool orderStatistics>
+    inline typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::SizeType
+    RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::
     erase(const KeyType &key) {
         Pair<Iterator, Iterator> range = equalRange(key);
         SizeType count = tinystl::distance(range.first, range.second);
@@ -837,8 +1522,8 @@ namespace tinystl {
     }
 
     template<typename Key, typename Value, typename KeyOfValue,
-             typename Compare, typename _Alloc>
-    void RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::
+             typename Compare, typename _Alloc, bool orderStatistics>
+    void RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::
     erase(Iterator first, Iterator second) {
         if(first == begin() and second == end()) {
             clear();
@@ -850,8 +1535,8 @@ namespace tinystl {
     }
 
     template<typename Key, typename Value, typename KeyOfValue,
-             typename Compare, typename _Alloc>
-    inline void RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::clear() {
+             typename Compare, typename _Alloc, bool orderStatistics>
+    inline void RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::clear() {
         __erase(_root());
         _root() = nullptr;
         _leftMost() = _header;
@@ -860,16 +1545,24 @@ namespace tinystl {
     }
 
     template<typename Key, typename Value, typename KeyOfValue,
-             typename Compare, typename _Alloc>
-    inline typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::Iterator
-    RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::find(const KeyType &key) {
+             typename Compare, typename _Alloc, bool orderStatistics>
+    inline typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::Iterator
+    RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::find(const KeyType &key) {
         return static_cast<const __Self* const>(this)->find(key).removeConst();
     }
 
     template<typename Key, typename Value, typename KeyOfValue,
-             typename Compare, typename _Alloc>
-    inline typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::ConstIterator
-    RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::find(const KeyType &key) const {
+             typename Compare, typename _Alloc, bool orderStatistics>
+    inline typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::ConstIterator
+    RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::find(const KeyType &key) const {
+        return _find(key);
+    }
+
+    template<typename Key, typename Value, typename KeyOfValue,
+             typename Compare, typename _Alloc, bool orderStatistics>
+    template<typename K>
+    inline typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::ConstIterator
+    RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::_find(const K &key) const {
         _LinkType target = _header;
         _LinkType cur = _root();
         while(cur) {
@@ -886,24 +1579,32 @@ namespace tinystl {
     }
 
     template<typename Key, typename Value, typename KeyOfValue,
-             typename Compare, typename _Alloc>
-    inline typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::SizeType
-    RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::count(const KeyType &key) const {
+             typename Compare, typename _Alloc, bool orderStatistics>
+    inline typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::SizeType
+    RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::count(const KeyType &key) const {
         Pair<ConstIterator, ConstIterator> range = equalRange(key);
         return tinystl::distance(range.first, range.second);
     }
 
     template<typename Key, typename Value, typename KeyOfValue,
-             typename Compare, typename _Alloc>
-    inline typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::Iterator
-    RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::lowerBound(const KeyType &key) {
+             typename Compare, typename _Alloc, bool orderStatistics>
+    inline typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::Iterator
+    RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::lowerBound(const KeyType &key) {
         return static_cast<const __Self* const>(this)->lowerBound(key).removeConst();
     }
 
     template<typename Key, typename Value, typename KeyOfValue,
-             typename Compare, typename _Alloc>
-    inline typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::ConstIterator
-    RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::lowerBound(const KeyType &key) const {
+             typename Compare, typename _Alloc, bool orderStatistics>
+    inline typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::ConstIterator
+    RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::lowerBound(const KeyType &key) const {
+        return _lowerBound(key);
+    }
+
+    template<typename Key, typename Value, typename KeyOfValue,
+             typename Compare, typename _Alloc, bool orderStatistics>
+    template<typename K>
+    inline typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::ConstIterator
+    RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::_lowerBound(const K &key) const {
         _LinkType rangeFirst = _header;
         _LinkType cur = _root();
         while(cur) {
@@ -918,16 +1619,24 @@ namespace tinystl {
     }
 
     template<typename Key, typename Value, typename KeyOfValue,
-             typename Compare, typename _Alloc>
-    inline typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::Iterator
-    RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::upperBound(const KeyType &key) {
+             typename Compare, typename _Alloc, bool orderStatistics>
+    inline typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::Iterator
+    RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::upperBound(const KeyType &key) {
         return static_cast<const __Self* const>(this)->upperBound(key).removeConst();
     }
 
     template<typename Key, typename Value, typename KeyOfValue,
-             typename Compare, typename _Alloc>
-    inline typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::ConstIterator
-    RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::upperBound(const KeyType &key) const {
+             typename Compare, typename _Alloc, bool orderStatistics>
+    inline typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::ConstIterator
+    RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::upperBound(const KeyType &key) const {
+        return _upperBound(key);
+    }
+
+    template<typename Key, typename Value, typename KeyOfValue,
+             typename Compare, typename _Alloc, bool orderStatistics>
+    template<typename K>
+    inline typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::ConstIterator
+    RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::_upperBound(const K &key) const {
         _LinkType rangeLast = _header;
         _LinkType cur = _root();
         while(cur) {
@@ -942,25 +1651,25 @@ namespace tinystl {
     }
 
     template<typename Key, typename Value, typename KeyOfValue,
-             typename Compare, typename _Alloc>
-    inline Pair<typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::Iterator,
-                typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::Iterator>
-    RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::equalRange(const KeyType &key) {
+             typename Compare, typename _Alloc, bool orderStatistics>
+    inline Pair<typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::Iterator,
+                typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::Iterator>
+    RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::equalRange(const KeyType &key) {
         return makePair(lowerBound(key), upperBound(key));
     }
 
     template<typename Key, typename Value, typename KeyOfValue,
-             typename Compare, typename _Alloc>
-    inline Pair<typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::ConstIterator,
-                typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::ConstIterator>
-    RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::equalRange(const KeyType &key) const {
+             typename Compare, typename _Alloc, bool orderStatistics>
+    inline Pair<typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::ConstIterator,
+                typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::ConstIterator>
+    RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::equalRange(const KeyType &key) const {
         return makePair(lowerBound(key), upperBound(key));
     }
 
     template<typename Key, typename Value, typename KeyOfValue,
-             typename Compare, typename _Alloc>
-    inline typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::SizeType
-    RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::_blackCount(_BasePtr leaf, _BasePtr root) const {
+             typename Compare, typename _Alloc, bool orderStatistics>
+    inline typename RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::SizeType
+    RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::_blackCount(_BasePtr leaf, _BasePtr root) const {
         if(!leaf) {
             return 0;
         }
@@ -973,9 +1682,9 @@ namespace tinystl {
     }
 
     template<typename Key, typename Value, typename KeyOfValue,
-             typename Compare, typename _Alloc>
+             typename Compare, typename _Alloc, bool orderStatistics>
     inline bool
-    RBTree<Key, Value, KeyOfValue, Compare, _Alloc>::rbVerify() const {
+    RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics>::rbVerify() const {
         if(_nodeCount == 0) {
             return _root() == nullptr && _leftMost() == _header &&
                 _rightMost() == _header;
@@ -1001,6 +1710,13 @@ namespace tinystl {
             if(!leftSon && !rightSon && _blackCount(it._node, _root()) !=blackCount) {
                 return false;
             }
+
+            if(!_Augment::verify(it._node)) {
+                return false;
+            }
+        }
+        if(orderStatistics && _Augment::size(_root()) != _nodeCount) {
+            return false;
         }
         if(_leftMost() != __RBTreeNodeBase::getMinNode(_root())) {
             return false;
@@ -1012,52 +1728,52 @@ namespace tinystl {
     }
 
     template<typename Key, typename Value, typename KeyOfValue,
-             typename Compare, typename _Alloc>
-    inline void swap(RBTree<Key, Value, KeyOfValue, Compare, _Alloc> &lhs,
-                     RBTree<Key, Value, KeyOfValue, Compare, _Alloc> &rhs) {
+             typename Compare, typename _Alloc, bool orderStatistics>
+    inline void swap(RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics> &lhs,
+                     RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics> &rhs) {
         lhs.swap(rhs);
     }
 
     template<typename Key, typename Value, typename KeyOfValue,
-             typename Compare, typename _Alloc>
-    inline bool operator==(const RBTree<Key, Value, KeyOfValue, Compare, _Alloc> &lhs,
-                           const RBTree<Key, Value, KeyOfValue, Compare, _Alloc> &rhs) {
+             typename Compare, typename _Alloc, bool orderStatistics>
+    inline bool operator==(const RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics> &lhs,
+                           const RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics> &rhs) {
         return lhs.size() == rhs.size() &&
-            equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+            tinystl::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
     }
 
     template<typename Key, typename Value, typename KeyOfValue,
-             typename Compare, typename _Alloc>
-    inline bool operator!=(const RBTree<Key, Value, KeyOfValue, Compare, _Alloc> &lhs,
-                           const RBTree<Key, Value, KeyOfValue, Compare, _Alloc> &rhs) {
+             typename Compare, typename _Alloc, bool orderStatistics>
+    inline bool operator!=(const RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics> &lhs,
+                           const RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics> &rhs) {
         return !(lhs == rhs);
     }
 
     template<typename Key, typename Value, typename KeyOfValue,
-             typename Compare, typename _Alloc>
-    inline bool operator<(const RBTree<Key, Value, KeyOfValue, Compare, _Alloc> &lhs,
-                          const RBTree<Key, Value, KeyOfValue, Compare, _Alloc> &rhs) {
+             typename Compare, typename _Alloc, bool orderStatistics>
+    inline bool operator<(const RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics> &lhs,
+                          const RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics> &rhs) {
         return less(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
     }
 
     template<typename Key, typename Value, typename KeyOfValue,
-             typename Compare, typename _Alloc>
-    inline bool operator>(const RBTree<Key, Value, KeyOfValue, Compare, _Alloc> &lhs,
-                          const RBTree<Key, Value, KeyOfValue, Compare, _Alloc> &rhs) {
+             typename Compare, typename _Alloc, bool orderStatistics>
+    inline bool operator>(const RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics> &lhs,
+                          const RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics> &rhs) {
         return greater(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
     }
 
     template<typename Key, typename Value, typename KeyOfValue,
-             typename Compare, typename _Alloc>
-    inline bool operator<=(const RBTree<Key, Value, KeyOfValue, Compare, _Alloc> &lhs,
-                          const RBTree<Key, Value, KeyOfValue, Compare, _Alloc> &rhs) {
+             typename Compare, typename _Alloc, bool orderStatistics>
+    inline bool operator<=(const RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics> &lhs,
+                          const RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics> &rhs) {
         return !(lhs > rhs);
     }
 
     template<typename Key, typename Value, typename KeyOfValue,
-             typename Compare, typename _Alloc>
-    inline bool operator>=(const RBTree<Key, Value, KeyOfValue, Compare, _Alloc> &lhs,
-                           const RBTree<Key, Value, KeyOfValue, Compare, _Alloc> &rhs) {
+             typename Compare, typename _Alloc, bool orderStatistics>
+    inline bool operator>=(const RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics> &lhs,
+                           const RBTree<Key, Value, KeyOfValue, Compare, _Alloc, orderStatistics> &rhs) {
         return !(lhs < rhs);
     }
 
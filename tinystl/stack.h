@@ -19,12 +19,19 @@ namespace tinystl {
 
     public:
         explicit Stack(const Container &cont=Container()): __container(cont) {};
+        explicit Stack(Container &&cont): __container(tinystl::move(cont)) {};
         Stack(const _Self &other) = default;
+        Stack(_Self &&other) = default;
+        _Self& operator=(const _Self &other) = default;
+        _Self& operator=(_Self &&other) = default;
         Reference top() { return __container.back(); };
         ConstReference top() const { return __container.back(); };
         bool empty() const { return __container.empty(); };
         SizeType size() const { return __container.size(); };
         void push(const T &value) { __container.pushBack(value); };
+        void push(T &&value) { __container.pushBack(tinystl::move(value)); };
+        template<typename... Args>
+        void emplace(Args&&... args) { __container.emplaceBack(tinystl::forward<Args>(args)...); }
         void pop() { __container.popBack(); };
         void swap(_Self &other) { using tinystl::swap; swap(__container, other.__container); };
 
@@ -1,6 +1,8 @@
 #ifndef TINYSTL_TYPETRAINTS_H
 #define TINYSTL_TYPETRAINTS_H
 
+#include <type_traits>
+
 namespace tinystl {
     struct TrueType {
     };
@@ -167,6 +169,51 @@ namespace tinystl {
     MAKE_INTEGER(long long);
     MAKE_INTEGER(unsigned long long);
 
+    template<bool value>
+    struct BoolType {
+        using Type = FalseType;
+    };
+
+    template<>
+    struct BoolType<true> {
+        using Type = TrueType;
+    };
+
+    // ----------------------------------------------------------------------
+    // 能否通过memcpy把对象搬到新的地址,并且不再析构原来的对象
+    // 不持有指向自身的指针的类型一般都满足,可以为这样的类型特化
+    template<typename T>
+    struct IsRelocatable {
+        using Relocatable = typename BoolType<std::is_trivially_copyable<T>::value>::Type;
+    };
+
+    // ----------------------------------------------------------------------
+    // cond为true时才有Type,用于在重载决议中去掉不满足条件的模板
+    template<bool cond, typename T = void>
+    struct EnableIf {};
+
+    template<typename T>
+    struct EnableIf<true, T> {
+        using Type = T;
+    };
+
+    template<typename T>
+    struct __VoidType {
+        using Type = void;
+    };
+
+    // 比较函数或哈希函数定义了IsTransparent类型时,能接受键以外的参数,
+    // 查找时不需要先构造一个临时的键
+    template<typename T, typename = void>
+    struct IsTransparent {
+        static const bool value = false;
+    };
+
+    template<typename T>
+    struct IsTransparent<T, typename __VoidType<typename T::IsTransparent>::Type> {
+        static const bool value = true;
+    };
+
     // ----------------------------------------------------------------------
     // remove const
     template<typename T>
@@ -188,6 +235,40 @@ namespace tinystl {
     struct RemoveConst<const T&> {
         using ResultType = T&;
     };
+
+    // ----------------------------------------------------------------------
+    // remove reference
+    template<typename T>
+    struct RemoveReference {
+        using ResultType = T;
+    };
+
+    template<typename T>
+    struct RemoveReference<T&> {
+        using ResultType = T;
+    };
+
+    template<typename T>
+    struct RemoveReference<T&&> {
+        using ResultType = T;
+    };
+
+    // ----------------------------------------------------------------------
+    // move and forward
+    template<typename T>
+    inline typename RemoveReference<T>::ResultType&& move(T &&value) noexcept {
+        return static_cast<typename RemoveReference<T>::ResultType&&>(value);
+    }
+
+    template<typename T>
+    inline T&& forward(typename RemoveReference<T>::ResultType &value) noexcept {
+        return static_cast<T&&>(value);
+    }
+
+    template<typename T>
+    inline T&& forward(typename RemoveReference<T>::ResultType &&value) noexcept {
+        return static_cast<T&&>(value);
+    }
 }
 
 #endif
@@ -27,12 +27,12 @@ namespace tinystl {
         ForwardIterator cur = result;
         try {
             while(first != last) {
-                construct(&(*cur), *first);
+                tinystl::construct(&(*cur), *first);
                 ++cur;
                 ++first;
             }
         } catch(...) {
-            destroy(result, cur);
+            tinystl::destroy(result, cur);
             throw;
         }
         return cur;
@@ -45,12 +45,70 @@ namespace tinystl {
                                    typename TypeTraits<typename IteratorTraits<ForwardIterator>::ValueType>::isPODType());
     }
 
+    // -------------------------------------uninitializedMove----------------------------------
+
+    template<typename InputIterator, typename ForwardIterator>
+    inline ForwardIterator uninitializedMoveAux(InputIterator first,
+                                                InputIterator last,
+                                                ForwardIterator result,
+                                                TrueType) {
+        return tinystl::copy(first, last, result);
+    }
+
+    template<typename InputIterator, typename ForwardIterator>
+    inline ForwardIterator uninitializedMoveAux(InputIterator first,
+                                                InputIterator last,
+                                                ForwardIterator result,
+                                                FalseType) {
+        ForwardIterator cur = result;
+        try {
+            while(first != last) {
+                tinystl::construct(&(*cur), tinystl::move(*first));
+                ++cur;
+                ++first;
+            }
+        } catch(...) {
+            tinystl::destroy(result, cur);
+            throw;
+        }
+        return cur;
+    }
+
+    template<typename InputIterator, typename ForwardIterator>
+    inline ForwardIterator uninitializedMove(InputIterator first, InputIterator last,
+                                             ForwardIterator result) {
+        return uninitializedMoveAux(first, last, result,
+                                    typename TypeTraits<typename IteratorTraits<ForwardIterator>::ValueType>::isPODType());
+    }
+
+    template<typename InputIterator, typename ForwardIterator>
+    inline ForwardIterator __uninitializedMoveIfNoexcept(InputIterator first, InputIterator last,
+                                                         ForwardIterator result, TrueType) {
+        return tinystl::uninitializedMove(first, last, result);
+    }
+
+    template<typename InputIterator, typename ForwardIterator>
+    inline ForwardIterator __uninitializedMoveIfNoexcept(InputIterator first, InputIterator last,
+                                                         ForwardIterator result, FalseType) {
+        return tinystl::uninitializedCopy(first, last, result);
+    }
+
+    // 移动构造可能抛出异常时改为复制,保证搬移失败后原来的元素不变
+    template<typename InputIterator, typename ForwardIterator>
+    inline ForwardIterator uninitializedMoveIfNoexcept(InputIterator first, InputIterator last,
+                                                       ForwardIterator result) {
+        using ValueType = typename IteratorTraits<ForwardIterator>::ValueType;
+        return __uninitializedMoveIfNoexcept(first, last, result,
+                                             typename BoolType<std::is_nothrow_move_constructible<ValueType>::value
+                                                               || !std::is_copy_constructible<ValueType>::value>::Type());
+    }
+
     // -------------------------------------uninitializedFill----------------------------------
 
     template<typename ForwardIterator, typename T>
     inline void uninitializedFillAux(ForwardIterator first, ForwardIterator last,
                                      const T &value, TrueType) {
-        return fill(first, last, value);
+        return tinystl::fill(first, last, value);
     }
 
     template<typename ForwardIterator, typename T>
@@ -59,11 +117,11 @@ namespace tinystl {
         ForwardIterator cur = first;
         try {
             while(cur != last) {
-                construct(&(*cur), value);
+                tinystl::construct(&(*cur), value);
                 ++cur;
             }
         } catch(...) {
-            destroy(first, cur);
+            tinystl::destroy(first, cur);
             throw;
         }
     }
@@ -82,7 +140,7 @@ namespace tinystl {
     inline ForwardIterator uninitializedFillNAux(ForwardIterator first,
                                               Size count,
                                               const T &value, TrueType) {
-        return fillN(first, count, value);
+        return tinystl::fillN(first, count, value);
     }
 
     template<typename ForwardIterator, typename Size, typename T>
@@ -92,11 +150,11 @@ namespace tinystl {
         ForwardIterator cur = first;
         try {
             while(count--) {
-                construct(&(*cur), value);
+                tinystl::construct(&(*cur), value);
                 ++cur;
             }
         } catch(...) {
-            destroy(first, cur);
+            tinystl::destroy(first, cur);
             throw;
         }
         return cur;
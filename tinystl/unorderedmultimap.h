@@ -0,0 +1,196 @@
+#ifndef UNORDERED_MULTIMAP_H
+#define UNORDERED_MULTIMAP_H
+
+#include "hashtable.h"
+#include "hash.h"
+#include "algobase.h"
+#include "alloc.h"
+#include "pair.h"
+
+namespace tinystl {
+
+    template<typename Key, typename T, typename HashFun=Hash<Key>,
+             typename EqualKey=Equal<Key>, typename _Alloc=Alloc>
+    class UnorderedMultiMap {
+    public:
+        using KeyType = Key;
+        using MappedType = T;
+        using ValueType = Pair<KeyType, MappedType>;
+        using SizeType = std::size_t;
+        using DifferenceType = std::ptrdiff_t;
+        using Hasher = HashFun;
+        using KeyEqual = EqualKey;
+
+        using Reference = ValueType&;
+        using ConstReference = const ValueType&;
+        using Pointer = ValueType*;
+        using ConstPointer = const ValueType*;
+
+    protected:
+        struct _KeyOfValue {
+            const KeyType& operator()(const ValueType &value) const {
+                return value.first;
+            }
+        };
+        using _Container = HashTable<ValueType, KeyType, HashFun, _KeyOfValue,
+                                     EqualKey, _Alloc>;
+
+    private:
+        using __Self = UnorderedMultiMap<Key, T, HashFun, EqualKey, _Alloc>;
+
+    public:
+        using Iterator = typename _Container::Iterator;
+        using ConstIterator = typename _Container::ConstIterator;
+
+        UnorderedMultiMap() = default;
+        explicit UnorderedMultiMap(SizeType bucketCount, const HashFun &hash=HashFun(),
+                                   const EqualKey &equal=EqualKey(), const _Alloc &alloc=_Alloc())
+            : __container(bucketCount, equal, _KeyOfValue(), hash, alloc) {}
+        explicit UnorderedMultiMap(const _Alloc &alloc): __container(alloc) {}
+        template<typename InputIterator>
+        UnorderedMultiMap(InputIterator first, InputIterator last, SizeType bucketCount=0,
+                          const HashFun &hash=HashFun(), const EqualKey &equal=EqualKey(),
+                          const _Alloc &alloc=_Alloc())
+            : __container(bucketCount, equal, _KeyOfValue(), hash, alloc) {
+            __container.insertEqual(first, last);
+        }
+        UnorderedMultiMap(const __Self&) = default;
+        UnorderedMultiMap(__Self&&) = default;
+        __Self& operator=(const __Self&) = default;
+        __Self& operator=(__Self&&) = default;
+
+        Iterator begin() { return __container.begin(); }
+        ConstIterator begin() const { return __container.begin(); }
+        ConstIterator cbegin() const { return __container.cbegin(); }
+        Iterator end() { return __container.end(); }
+        ConstIterator end() const { return __container.end(); }
+        ConstIterator cend() const { return __container.cend(); }
+
+        bool empty() const { return __container.empty(); }
+        SizeType size() const { return __container.size(); }
+        SizeType maxSize() const { return __container.maxSize(); }
+        _Alloc getAllocator() const { return __container.getAllocator(); }
+
+        void clear() { __container.clear(); }
+
+        Iterator insert(const ValueType &value) {
+            return __container.insertEqual(value);
+        }
+        Iterator insert(ValueType &&value) {
+            return __container.insertEqual(tinystl::move(value));
+        }
+        template<typename InputIterator>
+        void insert(InputIterator first, InputIterator last) {
+            __container.insertEqual(first, last);
+        }
+
+        template<typename... Args>
+        Iterator emplace(Args&&... args) {
+            return __container.emplaceEqual(tinystl::forward<Args>(args)...);
+        }
+
+        void erase(Iterator pos) { __container.erase(pos); }
+        void erase(ConstIterator pos) { __container.erase(pos); }
+        void erase(Iterator first, Iterator last) { __container.erase(first, last); }
+        SizeType erase(const KeyType &key) { return __container.erase(key); }
+
+        void swap(__Self &other) {
+            using tinystl::swap;
+            tinystl::swap(__container, other.__container);
+        }
+
+        SizeType count(const KeyType &key) const {
+            return __container.count(key);
+        }
+        Iterator find(const KeyType &key) {
+            return __container.find(key);
+        }
+        ConstIterator find(const KeyType &key) const {
+            return __container.find(key);
+        }
+        Pair<Iterator, Iterator> equalRange(const KeyType &key) {
+            return __container.equalRange(key);
+        }
+        Pair<ConstIterator, ConstIterator> equalRange(const KeyType &key) const {
+            return __container.equalRange(key);
+        }
+
+        // 哈希函数和比较函数都定义了IsTransparent时,可以用任何它们能接受的对象查找
+        template<typename K, typename H = HashFun, typename E = EqualKey,
+                 typename = typename EnableIf<IsTransparent<H>::value &&
+                                              IsTransparent<E>::value>::Type>
+        SizeType count(const K &key) const {
+            return __container.count(key);
+        }
+        template<typename K, typename H = HashFun, typename E = EqualKey,
+                 typename = typename EnableIf<IsTransparent<H>::value &&
+                                              IsTransparent<E>::value>::Type>
+        Iterator find(const K &key) {
+            return __container.find(key);
+        }
+        template<typename K, typename H = HashFun, typename E = EqualKey,
+                 typename = typename EnableIf<IsTransparent<H>::value &&
+                                              IsTransparent<E>::value>::Type>
+        ConstIterator find(const K &key) const {
+            return __container.find(key);
+        }
+        template<typename K, typename H = HashFun, typename E = EqualKey,
+                 typename = typename EnableIf<IsTransparent<H>::value &&
+                                              IsTransparent<E>::value>::Type>
+        Pair<Iterator, Iterator> equalRange(const K &key) {
+            return __container.equalRange(key);
+        }
+        template<typename K, typename H = HashFun, typename E = EqualKey,
+                 typename = typename EnableIf<IsTransparent<H>::value &&
+                                              IsTransparent<E>::value>::Type>
+        Pair<ConstIterator, ConstIterator> equalRange(const K &key) const {
+            return __container.equalRange(key);
+        }
+
+        SizeType bucketCount() const { return __container.bucketCount(); }
+        SizeType maxBucketCount() const { return __container.maxBucketCount(); }
+        SizeType bucketSize(SizeType bucketNo) const {
+            return __container.elementCountInSpecificBucket(bucketNo);
+        }
+        SizeType bucket(const KeyType &key) const { return __container.bucket(key); }
+        float loadFactor() const { return __container.loadFactor(); }
+        float maxLoadFactor() const { return __container.maxLoadFactor(); }
+        void maxLoadFactor(float loadFactor) { __container.maxLoadFactor(loadFactor); }
+        void rehash(SizeType bucketCount) { __container.rehash(bucketCount); }
+        // 预留能容纳count个元素的桶,考虑maxLoadFactor
+        void reserve(SizeType count) { __container.reserve(count); }
+
+        Hasher hashFunction() const { return __container.hashFunction(); }
+        KeyEqual keyEq() const { return __container.keyEq(); }
+
+        template<typename Key1, typename T1, typename HashFun1,
+                 typename EqualKey1, typename _Alloc1>
+        friend bool operator==(
+            const UnorderedMultiMap<Key1, T1, HashFun1, EqualKey1, _Alloc1> &lhs,
+            const UnorderedMultiMap<Key1, T1, HashFun1, EqualKey1, _Alloc1> &rhs);
+
+    private:
+        _Container __container;
+    };
+
+    template<typename Key, typename T, typename HashFun, typename EqualKey, typename _Alloc>
+    inline bool operator==(const UnorderedMultiMap<Key, T, HashFun, EqualKey, _Alloc> &lhs,
+                           const UnorderedMultiMap<Key, T, HashFun, EqualKey, _Alloc> &rhs) {
+        return lhs.__container == rhs.__container;
+    }
+
+    template<typename Key, typename T, typename HashFun, typename EqualKey, typename _Alloc>
+    inline bool operator!=(const UnorderedMultiMap<Key, T, HashFun, EqualKey, _Alloc> &lhs,
+                           const UnorderedMultiMap<Key, T, HashFun, EqualKey, _Alloc> &rhs) {
+        return !(lhs == rhs);
+    }
+
+    template<typename Key, typename T, typename HashFun, typename EqualKey, typename _Alloc>
+    inline void swap(UnorderedMultiMap<Key, T, HashFun, EqualKey, _Alloc> &lhs,
+                     UnorderedMultiMap<Key, T, HashFun, EqualKey, _Alloc> &rhs) {
+        lhs.swap(rhs);
+    }
+
+}
+
+#endif
@@ -0,0 +1,179 @@
+#ifndef UNORDERED_SET_H
+#define UNORDERED_SET_H
+
+#include "hashtable.h"
+#include "hash.h"
+#include "algobase.h"
+#include "alloc.h"
+#include "pair.h"
+
+namespace tinystl {
+
+    // 修改元素会改变它的哈希值,Iterator和ConstIterator都只能读取元素
+    template<typename Key, typename HashFun=Hash<Key>,
+             typename EqualKey=Equal<Key>, typename _Alloc=Alloc>
+    class UnorderedSet {
+    public:
+        using KeyType = Key;
+        using ValueType = Key;
+        using SizeType = std::size_t;
+        using DifferenceType = std::ptrdiff_t;
+        using Hasher = HashFun;
+        using KeyEqual = EqualKey;
+
+        using Reference = const ValueType&;
+        using ConstReference = const ValueType&;
+        using Pointer = const ValueType*;
+        using ConstPointer = const ValueType*;
+
+    protected:
+        struct _KeyOfValue {
+            const KeyType& operator()(const ValueType &value) const {
+                return value;
+            }
+        };
+        using _Container = HashTable<ValueType, KeyType, HashFun, _KeyOfValue,
+                                     EqualKey, _Alloc>;
+
+    private:
+        using __Self = UnorderedSet<Key, HashFun, EqualKey, _Alloc>;
+
+    public:
+        using Iterator = typename _Container::ConstIterator;
+        using ConstIterator = typename _Container::ConstIterator;
+
+        UnorderedSet() = default;
+        explicit UnorderedSet(SizeType bucketCount, const HashFun &hash=HashFun(),
+                              const EqualKey &equal=EqualKey(), const _Alloc &alloc=_Alloc())
+            : __container(bucketCount, equal, _KeyOfValue(), hash, alloc) {}
+        explicit UnorderedSet(const _Alloc &alloc): __container(alloc) {}
+        template<typename InputIterator>
+        UnorderedSet(InputIterator first, InputIterator last, SizeType bucketCount=0,
+                     const HashFun &hash=HashFun(), const EqualKey &equal=EqualKey(),
+                     const _Alloc &alloc=_Alloc())
+            : __container(bucketCount, equal, _KeyOfValue(), hash, alloc) {
+            __container.insertUnique(first, last);
+        }
+        UnorderedSet(const __Self&) = default;
+        UnorderedSet(__Self&&) = default;
+        __Self& operator=(const __Self&) = default;
+        __Self& operator=(__Self&&) = default;
+
+        Iterator begin() const { return __container.begin(); }
+        ConstIterator cbegin() const { return __container.cbegin(); }
+        Iterator end() const { return __container.end(); }
+        ConstIterator cend() const { return __container.cend(); }
+
+        bool empty() const { return __container.empty(); }
+        SizeType size() const { return __container.size(); }
+        SizeType maxSize() const { return __container.maxSize(); }
+        _Alloc getAllocator() const { return __container.getAllocator(); }
+
+        void clear() { __container.clear(); }
+
+        Pair<Iterator, bool> insert(const ValueType &value) {
+            return _toConst(__container.insertUnique(value));
+        }
+        Pair<Iterator, bool> insert(ValueType &&value) {
+            return _toConst(__container.insertUnique(tinystl::move(value)));
+        }
+        template<typename InputIterator>
+        void insert(InputIterator first, InputIterator last) {
+            __container.insertUnique(first, last);
+        }
+
+        template<typename... Args>
+        Pair<Iterator, bool> emplace(Args&&... args) {
+            return _toConst(__container.emplaceUnique(tinystl::forward<Args>(args)...));
+        }
+
+        void erase(ConstIterator pos) { __container.erase(pos); }
+        void erase(ConstIterator first, ConstIterator last) { __container.erase(first, last); }
+        SizeType erase(const KeyType &key) { return __container.erase(key); }
+
+        void swap(__Self &other) {
+            using tinystl::swap;
+            tinystl::swap(__container, other.__container);
+        }
+
+        SizeType count(const KeyType &key) const {
+            return __container.count(key);
+        }
+        Iterator find(const KeyType &key) const {
+            return __container.find(key);
+        }
+        Pair<Iterator, Iterator> equalRange(const KeyType &key) const {
+            return __container.equalRange(key);
+        }
+
+        // 哈希函数和比较函数都定义了IsTransparent时,可以用任何它们能接受的对象查找
+        template<typename K, typename H = HashFun, typename E = EqualKey,
+                 typename = typename EnableIf<IsTransparent<H>::value &&
+                                              IsTransparent<E>::value>::Type>
+        SizeType count(const K &key) const {
+            return __container.count(key);
+        }
+        template<typename K, typename H = HashFun, typename E = EqualKey,
+                 typename = typename EnableIf<IsTransparent<H>::value &&
+                                              IsTransparent<E>::value>::Type>
+        Iterator find(const K &key) const {
+            return __container.find(key);
+        }
+        template<typename K, typename H = HashFun, typename E = EqualKey,
+                 typename = typename EnableIf<IsTransparent<H>::value &&
+                                              IsTransparent<E>::value>::Type>
+        Pair<Iterator, Iterator> equalRange(const K &key) const {
+            return __container.equalRange(key);
+        }
+
+        SizeType bucketCount() const { return __container.bucketCount(); }
+        SizeType maxBucketCount() const { return __container.maxBucketCount(); }
+        SizeType bucketSize(SizeType bucketNo) const {
+            return __container.elementCountInSpecificBucket(bucketNo);
+        }
+        SizeType bucket(const KeyType &key) const { return __container.bucket(key); }
+        float loadFactor() const { return __container.loadFactor(); }
+        float maxLoadFactor() const { return __container.maxLoadFactor(); }
+        void maxLoadFactor(float loadFactor) { __container.maxLoadFactor(loadFactor); }
+        void rehash(SizeType bucketCount) { __container.rehash(bucketCount); }
+        // 预留能容纳count个元素的桶,考虑maxLoadFactor
+        void reserve(SizeType count) { __container.reserve(count); }
+
+        Hasher hashFunction() const { return __container.hashFunction(); }
+        KeyEqual keyEq() const { return __container.keyEq(); }
+
+        template<typename Key1, typename HashFun1, typename EqualKey1, typename _Alloc1>
+        friend bool operator==(const UnorderedSet<Key1, HashFun1, EqualKey1, _Alloc1> &lhs,
+                               const UnorderedSet<Key1, HashFun1, EqualKey1, _Alloc1> &rhs);
+
+    protected:
+        static Pair<Iterator, bool>
+        _toConst(const Pair<typename _Container::Iterator, bool> &result) {
+            return Pair<Iterator, bool>(result.first, result.second);
+        }
+
+    private:
+        _Container __container;
+    };
+
+    template<typename Key, typename HashFun, typename EqualKey, typename _Alloc>
+    inline bool operator==(const UnorderedSet<Key, HashFun, EqualKey, _Alloc> &lhs,
+                           const UnorderedSet<Key, HashFun, EqualKey, _Alloc> &rhs) {
+        return lhs.__container == rhs.__container;
+    }
+
+    template<typename Key, typename HashFun, typename EqualKey, typename _Alloc>
+    inline bool operator!=(const UnorderedSet<Key, HashFun, EqualKey, _Alloc> &lhs,
+                           const UnorderedSet<Key, HashFun, EqualKey, _Alloc> &rhs) {
+        return !(lhs == rhs);
+    }
+
+    template<typename Key, typename HashFun, typename EqualKey, typename _Alloc>
+    inline void swap(UnorderedSet<Key, HashFun, EqualKey, _Alloc> &lhs,
+                     UnorderedSet<Key, HashFun, EqualKey, _Alloc> &rhs) {
+        lhs.swap(rhs);
+    }
+
+}
+
+#endif
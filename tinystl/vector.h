@@ -2,12 +2,14 @@
 #define VECTOR_H
 
 #include <stdexcept>
+#include <cstring>
 #include "alloc.h"
 #include "algobase.h"
 #include "construct.h"
 #include "iterator.h"
 #include "uninitialized.h"
 #include "iteratorbase.h"
+#include "typetraits.h"
 
 namespace tinystl {
     // note
@@ -17,12 +19,15 @@ namespace tinystl {
 
     // 所以在此,使用VectorBase来完成空间的管理
     template<typename T, typename _Alloc>
-    class VectorBase {
+    class VectorBase: protected __AllocHolder<_Alloc> {
     public:
         using Allocator = SimpleAlloc<T, _Alloc>;
         VectorBase(): _start(nullptr), _finish(nullptr), _endOfStorage(nullptr) {}
-        VectorBase(std::size_t n): _start(nullptr), _finish(nullptr),
-                                   _endOfStorage(nullptr) {
+        explicit VectorBase(const _Alloc &alloc): __AllocHolder<_Alloc>(alloc), _start(nullptr),
+                                                  _finish(nullptr), _endOfStorage(nullptr) {}
+        VectorBase(std::size_t n, const _Alloc &alloc=_Alloc()): __AllocHolder<_Alloc>(alloc),
+                                                              _start(nullptr), _finish(nullptr),
+                                                              _endOfStorage(nullptr) {
             _start = _allocate(n);
             _finish = _start;
             _endOfStorage = _start + n;
@@ -33,13 +38,15 @@ namespace tinystl {
         }
 
     protected:
+        using __AllocHolder<_Alloc>::_getAlloc;
+
         T* _allocate(std::size_t n) {
-            return Allocator::allocate(n);
+            return Allocator::allocate(_getAlloc(), n);
         }
 
         void _deallocate(T *ptr, std::size_t n) {
             if(ptr) {
-                Allocator::deallocate(ptr, n);
+                Allocator::deallocate(_getAlloc(), ptr, n);
             }
         }
 
@@ -66,6 +73,8 @@ namespace tinystl {
     private:
         using Base = VectorBase<T, _Alloc>;
         using Self = Vector<T, _Alloc>;
+        using _Relocatable = typename IsRelocatable<T>::Relocatable;
+        using _HasReallocate = typename __HasReallocate<_Alloc>::Result;
 
     protected:
         // using 语句时名称在此作用域课件,函数的话会参与函数匹配过程
@@ -78,23 +87,41 @@ namespace tinystl {
     public:
         Vector() = default;
 
-        Vector(SizeType n, const T&value): Base(n) {
-            _finish = uninitializedFillN(_start, n, value);
+        explicit Vector(const _Alloc &alloc): Base(alloc) {}
+
+        Vector(SizeType n, const T&value, const _Alloc &alloc=_Alloc()): Base(n, alloc) {
+            _finish = tinystl::uninitializedFillN(_start, n, value);
+        }
+
+        Vector(SizeType n, const _Alloc &alloc=_Alloc()): Base(n, alloc) {
+            _finish = tinystl::uninitializedFillN(_start, n, ValueType());
         }
 
-        Vector(SizeType n): Base(n) {
-            _finish = uninitializedFillN(_start, n, ValueType());
+        Vector(const Self &other): Base(other.size(), other.getAllocator()) {
+            _finish = tinystl::uninitializedCopy(other.begin(), other.end(), _start);
         }
 
-        Vector(const Self &other): Base(other.size()) {
-            _finish = uninitializedCopy(other.begin(), other.end(), _start);
+        // 接管other的空间,other变为空
+        Vector(Self &&other) noexcept: Base(other.getAllocator()) {
+            _start = other._start;
+            _finish = other._finish;
+            _endOfStorage = other._endOfStorage;
+            other._start = other._finish = other._endOfStorage = nullptr;
         }
 
         template<typename InputIterator>
-        Vector(InputIterator first, InputIterator last) {
+        Vector(InputIterator first, InputIterator last, const _Alloc &alloc=_Alloc()): Base(alloc) {
             _initializeAux(first, last, typename IsInteger<InputIterator>::Integral());
         }
 
+        ~Vector() {
+            tinystl::destroy(_start, _finish);
+        }
+
+        _Alloc getAllocator() const {
+            return Base::_getAlloc();
+        }
+
         Iterator begin() {
             return _start;
         }
@@ -195,41 +222,73 @@ namespace tinystl {
         }
 
         void pushBack(const ValueType &value) {
+            emplaceBack(value);
+        }
+
+        void pushBack(ValueType &&value) {
+            emplaceBack(tinystl::move(value));
+        }
+
+        template<typename... Args>
+        void emplaceBack(Args&&... args) {
             if(end() != _endOfStorage) {
-                construct(_finish, value);
+                tinystl::construct(_finish, tinystl::forward<Args>(args)...);
                 ++_finish;
             } else {
-                _insertAux(end(), value);
+                _insertAux(end(), tinystl::forward<Args>(args)...);
             }
         }
 
         void swap(Self &other) {
             using tinystl::swap;
-            swap(_start, other._start);
-            swap(_finish, other._finish);
-            swap(_endOfStorage, other._endOfStorage);
+            tinystl::swap(_start, other._start);
+            tinystl::swap(_finish, other._finish);
+            tinystl::swap(_endOfStorage, other._endOfStorage);
+            Base::_swapAlloc(other);
         }
 
         Iterator insert(ConstIterator pos, const ValueType &value) {
-            SizeType n = pos - begin();
+            SizeType n = pos - cbegin();
+            insert(begin() + n, value);
+            return begin() + n;
+        }
+
+        void insert(Iterator pos, const ValueType &value) {
             if(_finish != _endOfStorage && pos == end()) {
-                construct(pos, value);
+                tinystl::construct(_finish, value);
                 ++_finish;
             } else {
                 _insertAux(pos, value);
             }
+        }
+
+        Iterator insert(ConstIterator pos, ValueType &&value) {
+            SizeType n = pos - cbegin();
+            insert(begin() + n, tinystl::move(value));
             return begin() + n;
         }
 
-        void insert(Iterator pos, const ValueType &value) {
+        void insert(Iterator pos, ValueType &&value) {
             if(_finish != _endOfStorage && pos == end()) {
-                construct(pos, value);
+                tinystl::construct(_finish, tinystl::move(value));
                 ++_finish;
             } else {
-                _insertAux(pos, value);
+                _insertAux(pos, tinystl::move(value));
             }
         }
 
+        template<typename... Args>
+        Iterator emplace(ConstIterator pos, Args&&... args) {
+            SizeType n = pos - cbegin();
+            if(_finish != _endOfStorage && pos == cend()) {
+                tinystl::construct(_finish, tinystl::forward<Args>(args)...);
+                ++_finish;
+            } else {
+                _insertAux(begin() + n, tinystl::forward<Args>(args)...);
+            }
+            return begin() + n;
+        }
+
         void insert(Iterator pos, SizeType n, const ValueType &value);
 
         Iterator insert(ConstIterator pos, SizeType n, const ValueType &value);
@@ -241,14 +300,14 @@ namespace tinystl {
         Iterator insert(ConstIterator pos, InputIterator first, InputIterator last);
 
         void popBack() {
-            destroy(_finish);
             --_finish;
+            tinystl::destroy(_finish);
         }
 
         Iterator erase(Iterator pos) {
-            copy(pos + 1, _finish, pos);
-            destroy(_finish);
+            tinystl::move(pos + 1, _finish, pos);
             --_finish;
+            tinystl::destroy(_finish);
             return pos;
         }
 
@@ -262,15 +321,15 @@ namespace tinystl {
                 return first;
             }
 
-            T *newFinish = copy(last, _finish, first);
-            destroy(newFinish, _finish);
+            T *newFinish = tinystl::move(last, _finish, first);
+            tinystl::destroy(newFinish, _finish);
             _finish = newFinish;
             return first;
         }
 
         Iterator erase(ConstIterator first, ConstIterator last) {
             Iterator iFirst = begin() + (first - cbegin());
-            Iterator iLast = begin() + (last - cend());
+            Iterator iLast = begin() + (last - cbegin());
             return erase(iFirst, iLast);
         }
 
@@ -290,6 +349,12 @@ namespace tinystl {
             erase(begin(), end());
         }
 
+        void reserve(SizeType n) {
+            if(n > capacity()) {
+                _reserveAux(n, _Relocatable());
+            }
+        }
+
         void assign(SizeType count, const T &value);
 
         template<typename InputIterator>
@@ -297,6 +362,14 @@ namespace tinystl {
 
         Self& operator=(const Self &other);
 
+        Self& operator=(Self &&other) noexcept {
+            if(this != &other) {
+                Self temp(tinystl::move(other));
+                swap(temp);
+            }
+            return *this;
+        }
+
     protected:
         void _rangeCheck(SizeType n) const {
             if(n >= size()) {
@@ -308,7 +381,7 @@ namespace tinystl {
         void _initializeAux(Integer n, Integer value, TrueType) {
             _start = _allocate(n);
             _endOfStorage = _start + n;
-            _finish = uninitializedFillN(_start, n, value);
+            _finish = tinystl::uninitializedFillN(_start, n, value);
         }
 
         template<typename InputIterator>
@@ -339,11 +412,112 @@ namespace tinystl {
             _start = _allocate(length);
             _finish = _start;
             _endOfStorage = _start + length;
-            _finish = uninitializedCopy(first, last, _start);
+            _finish = tinystl::uninitializedCopy(first, last, _start);
+        }
+
+        template<typename... Args>
+        void _insertAux(Iterator pos, Args&&... args);
+        template<typename... Args>
+        void _reallocInsert(Iterator pos, Args&&... args);
+        void _reallocFillInsert(Iterator pos, SizeType n, const T &value);
+        template<typename ForwardIterator>
+        void _reallocRangeInsert(Iterator pos, ForwardIterator first,
+                                 ForwardIterator last, SizeType n);
+
+        void _reserveAux(SizeType n, TrueType) {
+            _reallocate(n, _HasReallocate());
+        }
+
+        void _reserveAux(SizeType n, FalseType) {
+            T *newStart = _allocate(n);
+            try {
+                _relocateAround(newStart, n, _finish, 0, FalseType());
+            } catch(...) {
+                _deallocate(newStart, n);
+                throw;
+            }
+        }
+
+        // 交给分配器的reallocate,分配器可能原地扩展,只用于可以按字节搬移的元素
+        void _reallocate(SizeType newLength, TrueType) {
+            if(!_start) {
+                _reallocate(newLength, FalseType());
+                return;
+            }
+            const SizeType oldSize = size();
+            _start = static_cast<T *>(Base::_getAlloc().reallocate(_start, capacity() * sizeof(T),
+                                                                   newLength * sizeof(T)));
+            _finish = _start + oldSize;
+            _endOfStorage = _start + newLength;
+        }
+
+        void _reallocate(SizeType newLength, FalseType) {
+            T *newStart = _allocate(newLength);
+            _relocateAround(newStart, newLength, _finish, 0, TrueType());
+        }
+
+        // 在尾部追加元素时尝试用reallocate扩容,构造参数引用容器中的元素时不能使用
+        template<typename... Args>
+        bool _reallocAppend(SizeType newLength, TrueType, const Args&... args) {
+            if(_aliases(args...)) {
+                return false;
+            }
+            _reallocate(newLength, _HasReallocate());
+            return true;
+        }
+
+        template<typename... Args>
+        bool _reallocAppend(SizeType, FalseType, const Args&...) {
+            return false;
+        }
+
+        // 把pos之前的元素搬到newStart,pos之后的元素搬到其后n个位置,然后释放旧空间
+        // 中间的n个位置由调用者构造
+        // 可以按字节搬移的元素直接memcpy,旧空间中的元素不再析构
+        void _relocateAround(T *newStart, SizeType newLength, Iterator pos, SizeType n, TrueType) {
+            const SizeType before = pos - _start;
+            const SizeType after = _finish - pos;
+            if(before > 0) {
+                std::memcpy(static_cast<void *>(newStart), static_cast<const void *>(_start),
+                            before * sizeof(T));
+            }
+            if(after > 0) {
+                std::memcpy(static_cast<void *>(newStart + before + n),
+                            static_cast<const void *>(pos), after * sizeof(T));
+            }
+            _deallocate(_start, capacity());
+            _start = newStart;
+            _finish = newStart + before + n + after;
+            _endOfStorage = newStart + newLength;
         }
 
-        void _insertAux(Iterator pos, const T&value);
-        void _insertAux(Iterator pos);
+        // 其它元素逐个移动,移动构造可能抛出异常时改为复制
+        void _relocateAround(T *newStart, SizeType newLength, Iterator pos, SizeType n, FalseType) {
+            T *newFinish = tinystl::uninitializedMoveIfNoexcept(_start, pos, newStart);
+            try {
+                newFinish = tinystl::uninitializedMoveIfNoexcept(pos, _finish, newFinish + n);
+            } catch(...) {
+                tinystl::destroy(newStart, newFinish);
+                throw;
+            }
+            tinystl::destroy(_start, _finish);
+            _deallocate(_start, capacity());
+            _start = newStart;
+            _finish = newFinish;
+            _endOfStorage = newStart + newLength;
+        }
+
+        bool _aliases() const {
+            return false;
+        }
+
+        // 参数的地址落在[_start, _finish)中,说明引用的是容器中的元素或其成员
+        template<typename Arg, typename... Args>
+        bool _aliases(const Arg &arg, const Args&... args) const {
+            const char *ptr = reinterpret_cast<const char *>(&arg);
+            return !(ptr < reinterpret_cast<const char *>(_start) ||
+                     ptr >= reinterpret_cast<const char *>(_finish)) || _aliases(args...);
+        }
 
         void _fillInsert(Iterator pos, SizeType n, const ValueType &value);
 
@@ -384,40 +558,46 @@ namespace tinystl {
     };
 
     template<typename T, typename _Alloc>
-    void Vector<T, _Alloc>::_insertAux(Iterator pos, const T &value) {
+    template<typename... Args>
+    void Vector<T, _Alloc>::_insertAux(Iterator pos, Args&&... args) {
         if(_finish != _endOfStorage) {
-            construct(_finish, *(_finish + 1));
+            // 先构造副本,args可能引用容器中的元素
+            T copyObj(tinystl::forward<Args>(args)...);
+            tinystl::construct(_finish, tinystl::move(*(_finish - 1)));
             ++_finish;
-            T copyObj = value;
-            copyBackward(pos, _finish - 2, _finish - 1);
-            *pos = copyObj;
+            tinystl::moveBackward(pos, _finish - 2, _finish - 1);
+            *pos = tinystl::move(copyObj);
         } else {
-            const SizeType oldSize = size();
-            const SizeType newLength = oldSize? 2 * oldSize: 1;
-            T* newStart = _allocate(newLength);
-            T* newFinish = newStart;
-            T* newEndOfStorage = newStart + newLength;
-            try {
-                newFinish = uninitializedCopy(_start, pos, newStart);
-                construct(newFinish, value);
-                ++newFinish;
-                newFinish = uninitializedCopy(pos, _finish, newFinish);
-            } catch(...) {
-                destroy(newStart, newFinish);
-                _deallocate(newStart, newLength);
-                throw;
-            }
-            destroy(_start, _finish);
-            _deallocate(_start, capacity());
-            _start = newStart;
-            _finish = newFinish;
-            _endOfStorage = newEndOfStorage;
+            _reallocInsert(pos, tinystl::forward<Args>(args)...);
         }
     }
 
     template<typename T, typename _Alloc>
-    inline void Vector<T, _Alloc>::_insertAux(Iterator pos) {
-        _insertAux(pos, ValueType());
+    template<typename... Args>
+    void Vector<T, _Alloc>::_reallocInsert(Iterator pos, Args&&... args) {
+        const SizeType oldSize = size();
+        const SizeType newLength = oldSize? 2 * oldSize: 1;
+        if(pos == _finish && _reallocAppend(newLength, _Relocatable(), args...)) {
+            tinystl::construct(_finish, tinystl::forward<Args>(args)...);
+            ++_finish;
+            return;
+        }
+        // 先构造新元素再搬移原有元素,args引用容器中的元素时仍然有效
+        T *newStart = _allocate(newLength);
+        T *gap = newStart + (pos - _start);
+        try {
+            tinystl::construct(gap, tinystl::forward<Args>(args)...);
+        } catch(...) {
+            _deallocate(newStart, newLength);
+            throw;
+        }
+        try {
+            _relocateAround(newStart, newLength, pos, 1, _Relocatable());
+        } catch(...) {
+            tinystl::destroy(gap);
+            _deallocate(newStart, newLength);
+            throw;
+        }
     }
 
     template<typename T, typename _Alloc>
@@ -428,38 +608,44 @@ namespace tinystl {
         }
 
         if(_endOfStorage - _finish >= n) {
+            // value可能是容器中会被移动的元素
+            const T copyValue(value);
             const SizeType afterElementCount = _finish - pos;
             T * const oldFinish = _finish;
             if(afterElementCount > n) {
-                _finish = uninitializedCopy(_finish - n, _finish, _finish);
-                copyBackward(pos, pos + (afterElementCount - n), oldFinish);
-                fillN(pos, n, value);
+                _finish = tinystl::uninitializedMove(_finish - n, _finish, _finish);
+                tinystl::moveBackward(pos, pos + (afterElementCount - n), oldFinish);
+                tinystl::fillN(pos, n, copyValue);
             } else {
-                _finish = uninitializedCopy(pos, _finish,
+                _finish = tinystl::uninitializedMove(pos, _finish,
                                            _finish + (n - afterElementCount));
-                fillN(pos, oldFinish, value);
-                uninitializedFillN(oldFinish, n - afterElementCount, value);
+                tinystl::fill(pos, oldFinish, copyValue);
+                tinystl::uninitializedFillN(oldFinish, n - afterElementCount, copyValue);
             }
         } else {
-            const SizeType oldSize = size();
-            const SizeType newLength = oldSize + max(oldSize, n);
-            T * const newStart = _allocate(newLength);
-            T * newFinish = newStart;
-            T * const newEndOfStorage = newStart + newLength;
-            try {
-                newFinish = uninitializedCopy(_start, pos, newStart);
-                newFinish = uninitializedFillN(newFinish, n, value);
-                newFinish = uninitializedCopy(pos, _finish, newFinish);
-            } catch(...) {
-                destroy(newStart, newFinish);
-                _deallocate(newStart, newLength);
-                throw;
-            }
-            destroy(_start, _finish);
-            _deallocate(_start, oldSize);
-            _start = newStart;
-            _finish = newFinish;
-            _endOfStorage = newEndOfStorage;
+            _reallocFillInsert(pos, n, value);
+        }
+    }
+
+    template<typename T, typename _Alloc>
+    void Vector<T, _Alloc>::_reallocFillInsert(Iterator pos, SizeType n,
+                                               const ValueType &value) {
+        const SizeType oldSize = size();
+        const SizeType newLength = oldSize + max(oldSize, n);
+        T * const newStart = _allocate(newLength);
+        T * const gap = newStart + (pos - _start);
+        try {
+            tinystl::uninitializedFillN(gap, n, value);
+        } catch(...) {
+            _deallocate(newStart, newLength);
+            throw;
+        }
+        try {
+            _relocateAround(newStart, newLength, pos, n, _Relocatable());
+        } catch(...) {
+            tinystl::destroy(gap, gap + n);
+            _deallocate(newStart, newLength);
+            throw;
         }
     }
 
@@ -530,34 +716,39 @@ namespace tinystl {
             const SizeType afterItemCount = _finish - pos;
             T * const oldFinish = _finish;
             if(afterItemCount > n) {
-                _finish = uninitializedCopy(_finish - n, _finish, _finish);
-                copyBackward(pos, oldFinish - n, oldFinish);
+                _finish = tinystl::uninitializedMove(_finish - n, _finish, _finish);
+                tinystl::moveBackward(pos, oldFinish - n, oldFinish);
                 tinystl::copy(first, last, pos);
             } else {
-                _finish = uninitializedCopy(pos, _finish, _finish + (n - afterItemCount));
-                uninitializedFill(oldFinish, _finish - afterItemCount, ValueType());
+                _finish = tinystl::uninitializedMove(pos, _finish, _finish + (n - afterItemCount));
+                tinystl::uninitializedFill(oldFinish, _finish - afterItemCount, ValueType());
                 tinystl::copy(first, last, pos);
             }
         } else {
-            const SizeType oldSize = size();
-            const SizeType newLength = oldSize + max(oldSize, n);
-            T * newStart = _allocate(newLength);
-            T * newFinish = newStart;
-            T * newEndOfStorage = newStart + newLength;
-            try {
-                newFinish = uninitializedCopy(_start, pos, newFinish);
-                newFinish = uninitializedCopy(first, last, newFinish);
-                newFinish = uninitializedCopy(pos, _finish, newFinish);
-            } catch(...) {
-                destroy(newStart, newFinish);
-                _deallocate(newStart, newLength);
-                throw;
-            }
-            destroy(_start, _finish);
-            _deallocate(_start, _endOfStorage - _start);
-            _start = newStart;
-            _finish = newFinish;
-            _endOfStorage = newEndOfStorage;
+            _reallocRangeInsert(pos, first, last, n);
+        }
+    }
+
+    template<typename T, typename _Alloc>
+    template<typename ForwardIterator>
+    void Vector<T, _Alloc>::_reallocRangeInsert(Iterator pos, ForwardIterator first,
+                                                ForwardIterator last, SizeType n) {
+        const SizeType oldSize = size();
+        const SizeType newLength = oldSize + max(oldSize, n);
+        T * const newStart = _allocate(newLength);
+        T * const gap = newStart + (pos - _start);
+        try {
+            tinystl::uninitializedCopy(first, last, gap);
+        } catch(...) {
+            _deallocate(newStart, newLength);
+            throw;
+        }
+        try {
+            _relocateAround(newStart, newLength, pos, n, _Relocatable());
+        } catch(...) {
+            tinystl::destroy(gap, gap + n);
+            _deallocate(newStart, newLength);
+            throw;
         }
     }
 
@@ -591,13 +782,13 @@ namespace tinystl {
             T *newFinish = newStart;
             T *newEndOfStorage = newStart + count;
             try {
-                newFinish = uninitializedFillN(newStart, count, value);
+                newFinish = tinystl::uninitializedFillN(newStart, count, value);
             } catch(...) {
-                destroy(newStart, newFinish);
+                tinystl::destroy(newStart, newFinish);
                 _deallocate(newStart, count);
                 throw;
             }
-            destroy(_start, _finish);
+            tinystl::destroy(_start, _finish);
             _deallocate(_start, _endOfStorage - _start);
             _start = newStart;
             _finish = newFinish;
@@ -656,22 +847,22 @@ namespace tinystl {
                 erase(newFinish, _finish);
                 _finish = newFinish;
             } else {
-                T *newFinish = copyN(first, size(), _start);
+                T *newFinish = tinystl::copyN(first, size(), _start);
                 tinystl::advance(first, size());
-                _finish = uninitializedCopy(first, last, newFinish);
+                _finish = tinystl::uninitializedCopy(first, last, newFinish);
             }
         } else {
             T *newStart = _allocate(n);
             T *newFinish = newStart;
             T *newEndOfStorage = newStart + n;
             try {
-                newFinish = uninitializedCopy(first, last, newFinish);
+                newFinish = tinystl::uninitializedCopy(first, last, newFinish);
             } catch(...) {
-                destroy(newStart, newFinish);
+                tinystl::destroy(newStart, newFinish);
                 _deallocate(newStart, n);
                 throw;
             }
-            destroy(_start, _finish);
+            tinystl::destroy(_start, _finish);
             _deallocate(_start, _endOfStorage - _start);
             _start = newStart;
             _finish = newFinish;
@@ -688,7 +879,7 @@ namespace tinystl {
     template<typename T, typename _Alloc>
     inline bool operator==(const Vector<T, _Alloc> &lhs,
                            const Vector<T, _Alloc> &rhs) {
-        return lhs.size() == rhs.size() && equal(lhs.cbegin(), lhs.cend(), rhs.cbegin());
+        return lhs.size() == rhs.size() && tinystl::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin());
     }
 
     template<typename T, typename _Alloc>
@@ -721,6 +912,17 @@ namespace tinystl {
         return !(lhs < rhs);
     }
 
+    template<typename T, typename _Alloc>
+    inline void swap(Vector<T, _Alloc> &lhs, Vector<T, _Alloc> &rhs) {
+        lhs.swap(rhs);
+    }
+
+    // Vector只保存指向堆空间的指针,可以按字节搬移
+    template<typename T, typename _Alloc>
+    struct IsRelocatable<Vector<T, _Alloc>> {
+        using Relocatable = typename IsRelocatable<_Alloc>::Relocatable;
+    };
+
     template<typename T, typename _Alloc>
     Vector<T, _Alloc>& Vector<T, _Alloc>::operator=(const Vector<T,
                                                     _Alloc> &other) {